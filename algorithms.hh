@@ -10,6 +10,16 @@ Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
 #include "generic.hh"
 #include "exclusive_reduce.hh"
 
+// any of the first blocks lanes not positive, with a movemask instead of a loop over the lanes
+template <typename TYPE>
+static inline bool bad_lanes(TYPE v, int blocks)
+{
+	if (blocks <= 0)
+		return false;
+	uint64_t lanes = ~uint64_t(0) >> (64 - blocks);
+	return (vmovemask(vcgtz(v)) & lanes) != lanes;
+}
+
 template <typename VALUE, int WIDTH>
 struct SelfCorrectedUpdate<SIMD<VALUE, WIDTH>>
 {
@@ -63,11 +73,7 @@ struct MinSumAlgorithm<SIMD<VALUE, WIDTH>, UPDATE>
 	}
 	static bool bad(TYPE v, int blocks)
 	{
-		auto tmp = vcgtz(v);
-		for (int i = 0; i < blocks; ++i)
-			if (!tmp.v[i])
-				return true;
-		return false;
+		return bad_lanes(v, blocks);
 	}
 	static void update(TYPE *a, TYPE b)
 	{
@@ -75,11 +81,32 @@ struct MinSumAlgorithm<SIMD<VALUE, WIDTH>, UPDATE>
 	}
 };
 
-template <int WIDTH, typename UPDATE>
-struct MinSumAlgorithm<SIMD<int8_t, WIDTH>, UPDATE>
+// saturation of the fixed-point values and the range of the check node messages
+template <typename VALUE>
+struct FixedPointLimits;
+
+template <>
+struct FixedPointLimits<int8_t>
+{
+	static const int MAX = 127, LOW = -32, HIGH = 31;
+};
+
+template <>
+struct FixedPointLimits<int16_t>
+{
+	static const int MAX = 32767, LOW = -1024, HIGH = 1023;
+};
+
+// fixed-point min-sum, with the magnitudes offset by FACTOR/2 unless FACTOR is zero
+template <typename TYPE, typename UPDATE, int FACTOR>
+struct FixedMinSumAlgorithm;
+
+template <typename VALUE, int WIDTH, typename UPDATE, int FACTOR>
+struct FixedMinSumAlgorithm<SIMD<VALUE, WIDTH>, UPDATE, FACTOR>
 {
-	typedef int8_t VALUE;
 	typedef SIMD<VALUE, WIDTH> TYPE;
+	typedef FixedPointLimits<VALUE> LIMITS;
+	typedef UPDATE update_type;
 	static TYPE zero()
 	{
 		return vzero<TYPE>();
@@ -104,26 +131,41 @@ struct MinSumAlgorithm<SIMD<int8_t, WIDTH>, UPDATE>
 	{
 		return vreinterpret<TYPE>(vbsl(vceq(a, b), vmask(c), vmask(b)));
 	}
-	static void finalp(TYPE *links, int cnt)
+	static void magnitudes(TYPE *mags, TYPE *links, int cnt)
+	{
+		if constexpr (FACTOR) {
+			auto beta = vunsigned(vdup<TYPE>(std::nearbyint(0.5 * FACTOR)));
+			for (int i = 0; i < cnt; ++i)
+				mags[i] = vsigned(vqsub(vunsigned(vqabs(links[i])), beta));
+		} else {
+			for (int i = 0; i < cnt; ++i)
+				mags[i] = vqabs(links[i]);
+		}
+	}
+	static void minimums(TYPE *mins, TYPE *mags, int cnt)
 	{
-		TYPE mags[cnt];
-		for (int i = 0; i < cnt; ++i)
-			mags[i] = vqabs(links[i]);
-
-		TYPE mins[2];
 		mins[0] = vmin(mags[0], mags[1]);
 		mins[1] = vmax(mags[0], mags[1]);
 		for (int i = 2; i < cnt; ++i) {
 			mins[1] = vmin(mins[1], vmax(mins[0], mags[i]));
 			mins[0] = vmin(mins[0], mags[i]);
 		}
-
+	}
+	static TYPE signs(TYPE *links, int cnt)
+	{
 		TYPE signs = links[0];
 		for (int i = 1; i < cnt; ++i)
 			signs = eor(signs, links[i]);
-
+		return signs;
+	}
+	static void finalp(TYPE *links, int cnt)
+	{
+		TYPE mags[cnt], mins[2];
+		magnitudes(mags, links, cnt);
+		minimums(mins, mags, cnt);
+		TYPE sgns = signs(links, cnt);
 		for (int i = 0; i < cnt; ++i)
-			links[i] = sign(other(mags[i], mins[0], mins[1]), orr(eor(signs, links[i]), vdup<TYPE>(127)));
+			links[i] = sign(other(mags[i], mins[0], mins[1]), orr(eor(sgns, links[i]), vdup<TYPE>(LIMITS::MAX)));
 	}
 	static TYPE add(TYPE a, TYPE b)
 	{
@@ -135,16 +177,64 @@ struct MinSumAlgorithm<SIMD<int8_t, WIDTH>, UPDATE>
 	}
 	static bool bad(TYPE v, int blocks)
 	{
-		auto tmp = vcgtz(v);
-		for (int i = 0; i < blocks; ++i)
-			if (!tmp.v[i])
-				return true;
-		return false;
+		return bad_lanes(v, blocks);
 	}
 	static void update(TYPE *a, TYPE b)
 	{
-		UPDATE::update(a, vmin(vmax(b, vdup<TYPE>(-32)), vdup<TYPE>(31)));
+		UPDATE::update(a, vmin(vmax(b, vdup<TYPE>(LIMITS::LOW)), vdup<TYPE>(LIMITS::HIGH)));
+	}
+	// the compressed states pack 6 bit minimums and the signs into bytes, only for 8 bit values
+	static int states(int cnt)
+	{
+		return (cnt + 25) / 8;
 	}
+	static void messages(TYPE *links, TYPE *state, int cnt)
+	{
+		auto low = vmask(vdup<TYPE>(63));
+		auto min0 = vand(vmask(state[0]), low);
+		auto min1 = vand(vmask(state[1]), low);
+		TYPE idx = vreinterpret<TYPE>(vand(vmask(state[2]), low));
+		for (int w = 0, i = 0; i < cnt; ++w) {
+			auto bits = vmask(state[w]);
+			for (int n = w < 3 ? 6 : 0; n < 8 && i < cnt; ++n, ++i) {
+				TYPE mag = vreinterpret<TYPE>(vbsl(vceq(idx, vdup<TYPE>(i)), min1, min0));
+				TYPE neg = vreinterpret<TYPE>(vand(bits, vmask(vdup<TYPE>(1 << n))));
+				links[i] = vreinterpret<TYPE>(vbsl(vceqz(neg), vmask(vmin(mag, vdup<TYPE>(LIMITS::HIGH))), vmask(vneg(mag))));
+			}
+		}
+	}
+	static void finalc(TYPE *state, TYPE *links, int cnt)
+	{
+		TYPE mags[cnt], mins[2];
+		magnitudes(mags, links, cnt);
+		minimums(mins, mags, cnt);
+		TYPE sgns = signs(links, cnt);
+
+		TYPE idx = vzero<TYPE>();
+		for (int i = 0; i < cnt; ++i)
+			idx = vreinterpret<TYPE>(vbsl(vceq(mags[i], mins[0]), vmask(vdup<TYPE>(i)), vmask(idx)));
+
+		TYPE head[3] = { vmin(mins[0], vdup<TYPE>(32)), vmin(mins[1], vdup<TYPE>(32)), idx };
+		for (int w = 0, i = 0; w < states(cnt); ++w) {
+			TYPE bits = w < 3 ? head[w] : vzero<TYPE>();
+			for (int n = w < 3 ? 6 : 0; n < 8 && i < cnt; ++n, ++i) {
+				TYPE sgn = eor(sgns, links[i]);
+				bits = orr(bits, vreinterpret<TYPE>(vand(vcltz(sgn), vmask(vdup<TYPE>(1 << n)))));
+				links[i] = vmin(vmax(sign(other(mags[i], mins[0], mins[1]), orr(sgn, vdup<TYPE>(LIMITS::MAX))), vdup<TYPE>(LIMITS::LOW)), vdup<TYPE>(LIMITS::HIGH));
+			}
+			state[w] = bits;
+		}
+	}
+};
+
+template <int WIDTH, typename UPDATE>
+struct MinSumAlgorithm<SIMD<int8_t, WIDTH>, UPDATE> : FixedMinSumAlgorithm<SIMD<int8_t, WIDTH>, UPDATE, 0>
+{
+};
+
+template <int WIDTH, typename UPDATE>
+struct MinSumAlgorithm<SIMD<int16_t, WIDTH>, UPDATE> : FixedMinSumAlgorithm<SIMD<int16_t, WIDTH>, UPDATE, 0>
+{
 };
 
 template <typename VALUE, int WIDTH, typename UPDATE, int FACTOR>
@@ -191,11 +281,7 @@ struct OffsetMinSumAlgorithm<SIMD<VALUE, WIDTH>, UPDATE, FACTOR>
 	}
 	static bool bad(TYPE v, int blocks)
 	{
-		auto tmp = vcgtz(v);
-		for (int i = 0; i < blocks; ++i)
-			if (!tmp.v[i])
-				return true;
-		return false;
+		return bad_lanes(v, blocks);
 	}
 	static void update(TYPE *a, TYPE b)
 	{
@@ -204,9 +290,18 @@ struct OffsetMinSumAlgorithm<SIMD<VALUE, WIDTH>, UPDATE, FACTOR>
 };
 
 template <int WIDTH, typename UPDATE, int FACTOR>
-struct OffsetMinSumAlgorithm<SIMD<int8_t, WIDTH>, UPDATE, FACTOR>
+struct OffsetMinSumAlgorithm<SIMD<int8_t, WIDTH>, UPDATE, FACTOR> : FixedMinSumAlgorithm<SIMD<int8_t, WIDTH>, UPDATE, FACTOR>
+{
+};
+
+template <int WIDTH, typename UPDATE, int FACTOR>
+struct OffsetMinSumAlgorithm<SIMD<int16_t, WIDTH>, UPDATE, FACTOR> : FixedMinSumAlgorithm<SIMD<int16_t, WIDTH>, UPDATE, FACTOR>
+{
+};
+
+template <typename VALUE, int WIDTH, typename UPDATE, int FACTOR>
+struct MinSumCAlgorithm<SIMD<VALUE, WIDTH>, UPDATE, FACTOR>
 {
-	typedef int8_t VALUE;
 	typedef SIMD<VALUE, WIDTH> TYPE;
 	static TYPE zero()
 	{
@@ -220,67 +315,60 @@ struct OffsetMinSumAlgorithm<SIMD<int8_t, WIDTH>, UPDATE, FACTOR>
 	{
 		return vsign(a, b);
 	}
-	static TYPE eor(TYPE a, TYPE b)
-	{
-		return vreinterpret<TYPE>(veor(vmask(a), vmask(b)));
-	}
-	static TYPE orr(TYPE a, TYPE b)
+	static TYPE correction_factor(TYPE a, TYPE b)
 	{
-		return vreinterpret<TYPE>(vorr(vmask(a), vmask(b)));
+		TYPE apb = vabs(vadd(a, b));
+		TYPE apb2 = vadd(apb, apb);
+		TYPE amb = vabs(vsub(a, b));
+		TYPE amb2 = vadd(amb, amb);
+		TYPE factor2 = vdup<TYPE>(FACTOR * 2);
+		auto pc = vmask(vdup<TYPE>(VALUE(FACTOR) / VALUE(2)));
+		auto nc = vmask(vdup<TYPE>(-VALUE(FACTOR) / VALUE(2)));
+		pc = vand(pc, vand(vcgt(factor2, apb), vcgt(amb, apb2)));
+		nc = vand(nc, vand(vcgt(factor2, amb), vcgt(apb, amb2)));
+		return vreinterpret<TYPE>(vorr(pc, nc));
 	}
-	static TYPE other(TYPE a, TYPE b, TYPE c)
+	static TYPE minc(TYPE a, TYPE b)
 	{
-		return vreinterpret<TYPE>(vbsl(vceq(a, b), vmask(c), vmask(b)));
+		TYPE m = vmin(vabs(a), vabs(b));
+		TYPE x = vsign(vsign(m, a), b);
+		x = vadd(x, correction_factor(a, b));
+		return x;
 	}
 	static void finalp(TYPE *links, int cnt)
 	{
-		auto beta = vunsigned(vdup<TYPE>(std::nearbyint(0.5 * FACTOR)));
-		TYPE mags[cnt];
-		for (int i = 0; i < cnt; ++i)
-			mags[i] = vsigned(vqsub(vunsigned(vqabs(links[i])), beta));
-
-		TYPE mins[2];
-		mins[0] = vmin(mags[0], mags[1]);
-		mins[1] = vmax(mags[0], mags[1]);
-		for (int i = 2; i < cnt; ++i) {
-			mins[1] = vmin(mins[1], vmax(mins[0], mags[i]));
-			mins[0] = vmin(mins[0], mags[i]);
-		}
-
-		TYPE signs = links[0];
-		for (int i = 1; i < cnt; ++i)
-			signs = eor(signs, links[i]);
-
+		TYPE tmp[cnt];
+		CODE::exclusive_reduce(links, tmp, cnt, minc);
 		for (int i = 0; i < cnt; ++i)
-			links[i] = sign(other(mags[i], mins[0], mins[1]), orr(eor(signs, links[i]), vdup<TYPE>(127)));
+			links[i] = tmp[i];
 	}
 	static TYPE add(TYPE a, TYPE b)
 	{
-		return vqadd(a, b);
+		return vadd(a, b);
 	}
 	static TYPE sub(TYPE a, TYPE b)
 	{
-		return vqsub(a, b);
+		return vsub(a, b);
 	}
 	static bool bad(TYPE v, int blocks)
 	{
-		auto tmp = vcgtz(v);
-		for (int i = 0; i < blocks; ++i)
-			if (!tmp.v[i])
-				return true;
-		return false;
+		return bad_lanes(v, blocks);
 	}
 	static void update(TYPE *a, TYPE b)
 	{
-		UPDATE::update(a, vmin(vmax(b, vdup<TYPE>(-32)), vdup<TYPE>(31)));
+		UPDATE::update(a, b);
 	}
 };
 
+// fixed-point min-sum with correction
+template <typename TYPE, typename UPDATE, int FACTOR>
+struct FixedMinSumCAlgorithm;
 
 template <typename VALUE, int WIDTH, typename UPDATE, int FACTOR>
-struct MinSumCAlgorithm<SIMD<VALUE, WIDTH>, UPDATE, FACTOR>
+struct FixedMinSumCAlgorithm<SIMD<VALUE, WIDTH>, UPDATE, FACTOR>
 {
 	typedef SIMD<VALUE, WIDTH> TYPE;
+	typedef FixedPointLimits<VALUE> LIMITS;
 	static TYPE zero()
 	{
 		return vzero<TYPE>();
@@ -295,10 +383,10 @@ struct MinSumCAlgorithm<SIMD<VALUE, WIDTH>, UPDATE, FACTOR>
 	}
 	static TYPE correction_factor(TYPE a, TYPE b)
 	{
-		TYPE apb = vabs(vadd(a, b));
-		TYPE apb2 = vadd(apb, apb);
-		TYPE amb = vabs(vsub(a, b));
-		TYPE amb2 = vadd(amb, amb);
+		TYPE apb = vqabs(vqadd(a, b));
+		TYPE apb2 = vqadd(apb, apb);
+		TYPE amb = vqabs(vqsub(a, b));
+		TYPE amb2 = vqadd(amb, amb);
 		TYPE factor2 = vdup<TYPE>(FACTOR * 2);
 		auto pc = vmask(vdup<TYPE>(VALUE(FACTOR) / VALUE(2)));
 		auto nc = vmask(vdup<TYPE>(-VALUE(FACTOR) / VALUE(2)));
@@ -308,9 +396,9 @@ struct MinSumCAlgorithm<SIMD<VALUE, WIDTH>, UPDATE, FACTOR>
 	}
 	static TYPE minc(TYPE a, TYPE b)
 	{
-		TYPE m = vmin(vabs(a), vabs(b));
+		TYPE m = vmin(vqabs(a), vqabs(b));
 		TYPE x = vsign(vsign(m, a), b);
-		x = vadd(x, correction_factor(a, b));
+		x = vqadd(x, correction_factor(a, b));
 		return x;
 	}
 	static void finalp(TYPE *links, int cnt)
@@ -321,6 +409,98 @@ struct MinSumCAlgorithm<SIMD<VALUE, WIDTH>, UPDATE, FACTOR>
 			links[i] = tmp[i];
 	}
 	static TYPE add(TYPE a, TYPE b)
+	{
+		return vqadd(a, b);
+	}
+	static TYPE sub(TYPE a, TYPE b)
+	{
+		return vqsub(a, b);
+	}
+	static bool bad(TYPE v, int blocks)
+	{
+		return bad_lanes(v, blocks);
+	}
+	static void update(TYPE *a, TYPE b)
+	{
+		UPDATE::update(a, vmin(vmax(b, vdup<TYPE>(LIMITS::LOW)), vdup<TYPE>(LIMITS::HIGH)));
+	}
+};
+
+template <int WIDTH, typename UPDATE, int FACTOR>
+struct MinSumCAlgorithm<SIMD<int8_t, WIDTH>, UPDATE, FACTOR> : FixedMinSumCAlgorithm<SIMD<int8_t, WIDTH>, UPDATE, FACTOR>
+{
+};
+
+template <int WIDTH, typename UPDATE, int FACTOR>
+struct MinSumCAlgorithm<SIMD<int16_t, WIDTH>, UPDATE, FACTOR> : FixedMinSumCAlgorithm<SIMD<int16_t, WIDTH>, UPDATE, FACTOR>
+{
+};
+
+// 2^n is put together in the exponent bits, leaving 2^f with |f| <= 0.5 to a polynomial
+template <int WIDTH>
+static inline SIMD<float, WIDTH> vexp(SIMD<float, WIDTH> x)
+{
+	typedef SIMD<float, WIDTH> TYPE;
+	x = vclamp(vmul(x, vdup<TYPE>(1.44269504f)), -126.f, 126.f);
+	TYPE n = vcvt(vcvtn(x));
+	TYPE f = vsub(x, n);
+	TYPE p = vdup<TYPE>(0.0013400442f);
+	p = vadd(vmul(p, f), vdup<TYPE>(0.0096760467f));
+	p = vadd(vmul(p, f), vdup<TYPE>(0.055503272f));
+	p = vadd(vmul(p, f), vdup<TYPE>(0.24022107f));
+	p = vadd(vmul(p, f), vdup<TYPE>(0.69314718f));
+	p = vadd(vmul(p, f), vdup<TYPE>(1.0000001f));
+	TYPE e = vreinterpret<TYPE>(vcvtn(vmul(vadd(n, vdup<TYPE>(127)), vdup<TYPE>(8388608))));
+	return vmul(p, e);
+}
+
+// exponent bits give the integer part, log2(1+u) with 0 <= u < 1 of the mantissa is left to a polynomial
+template <int WIDTH>
+static inline SIMD<float, WIDTH> vlog(SIMD<float, WIDTH> x)
+{
+	typedef SIMD<float, WIDTH> TYPE;
+	typedef SIMD<int32_t, WIDTH> ITYPE;
+	auto bits = vmask(x);
+	TYPE e = vcvt(vreinterpret<ITYPE>(vand(bits, vmask(vdup<ITYPE>(0x7f800000)))));
+	e = vsub(vmul(e, vdup<TYPE>(1.f / 8388608)), vdup<TYPE>(127));
+	TYPE u = vreinterpret<TYPE>(vorr(vand(bits, vmask(vdup<ITYPE>(0x007fffff))), vmask(vdup<ITYPE>(0x3f800000))));
+	u = vsub(u, vdup<TYPE>(1));
+	TYPE p = vdup<TYPE>(0.015126939f);
+	p = vadd(vmul(p, u), vdup<TYPE>(-0.078155071f));
+	p = vadd(vmul(p, u), vdup<TYPE>(0.19238113f));
+	p = vadd(vmul(p, u), vdup<TYPE>(-0.32461399f));
+	p = vadd(vmul(p, u), vdup<TYPE>(0.47311261f));
+	p = vadd(vmul(p, u), vdup<TYPE>(-0.72051543f));
+	p = vadd(vmul(p, u), vdup<TYPE>(1.4426640f));
+	return vmul(vadd(e, vmul(p, u)), vdup<TYPE>(0.69314718f));
+}
+
+// log((exp(x)+1)/(exp(x)-1)) without the division
+template <int WIDTH>
+static inline SIMD<float, WIDTH> vphi(SIMD<float, WIDTH> x)
+{
+	typedef SIMD<float, WIDTH> TYPE;
+	TYPE t = vexp(vneg(vclamp(x, 0.000001f, 14.5f)));
+	return vsub(vlog(vadd(vdup<TYPE>(1), t)), vlog(vsub(vdup<TYPE>(1), t)));
+}
+
+template <int WIDTH, typename UPDATE>
+struct LogDomainSPA<SIMD<float, WIDTH>, UPDATE>
+{
+	typedef SIMD<float, WIDTH> TYPE;
+	static TYPE zero()
+	{
+		return vzero<TYPE>();
+	}
+	static TYPE one()
+	{
+		return vdup<TYPE>(1);
+	}
+	static TYPE phi(TYPE x)
+	{
+		return vphi(x);
+	}
+	static TYPE add(TYPE a, TYPE b)
 	{
 		return vadd(a, b);
 	}
@@ -328,13 +508,26 @@ struct MinSumCAlgorithm<SIMD<VALUE, WIDTH>, UPDATE, FACTOR>
 	{
 		return vsub(a, b);
 	}
+	static TYPE sign(TYPE a, TYPE b)
+	{
+		return vsign(a, b);
+	}
+	static void finalp(TYPE *links, int cnt)
+	{
+		TYPE mags[cnt], sums[cnt];
+		for (int i = 0; i < cnt; ++i)
+			mags[i] = phi(vabs(links[i]));
+		CODE::exclusive_reduce(mags, sums, cnt, add);
+
+		TYPE signs[cnt];
+		CODE::exclusive_reduce(links, signs, cnt, sign);
+
+		for (int i = 0; i < cnt; ++i)
+			links[i] = sign(phi(sums[i]), signs[i]);
+	}
 	static bool bad(TYPE v, int blocks)
 	{
-		auto tmp = vcgtz(v);
-		for (int i = 0; i < blocks; ++i)
-			if (!tmp.v[i])
-				return true;
-		return false;
+		return bad_lanes(v, blocks);
 	}
 	static void update(TYPE *a, TYPE b)
 	{
@@ -342,11 +535,10 @@ struct MinSumCAlgorithm<SIMD<VALUE, WIDTH>, UPDATE, FACTOR>
 	}
 };
 
-template <int WIDTH, typename UPDATE, int FACTOR>
-struct MinSumCAlgorithm<SIMD<int8_t, WIDTH>, UPDATE, FACTOR>
+template <int WIDTH, typename UPDATE, int LAMBDA>
+struct LambdaMinAlgorithm<SIMD<float, WIDTH>, UPDATE, LAMBDA>
 {
-	typedef int8_t VALUE;
-	typedef SIMD<VALUE, WIDTH> TYPE;
+	typedef SIMD<float, WIDTH> TYPE;
 	static TYPE zero()
 	{
 		return vzero<TYPE>();
@@ -355,56 +547,115 @@ struct MinSumCAlgorithm<SIMD<int8_t, WIDTH>, UPDATE, FACTOR>
 	{
 		return vdup<TYPE>(1);
 	}
+	static TYPE phi(TYPE x)
+	{
+		return vphi(x);
+	}
+	static TYPE add(TYPE a, TYPE b)
+	{
+		return vadd(a, b);
+	}
+	static TYPE sub(TYPE a, TYPE b)
+	{
+		return vsub(a, b);
+	}
 	static TYPE sign(TYPE a, TYPE b)
 	{
 		return vsign(a, b);
 	}
-	static TYPE correction_factor(TYPE a, TYPE b)
+	static void finalp(TYPE *links, int cnt)
 	{
-		TYPE apb = vqabs(vqadd(a, b));
-		TYPE apb2 = vqadd(apb, apb);
-		TYPE amb = vqabs(vqsub(a, b));
-		TYPE amb2 = vqadd(amb, amb);
-		TYPE factor2 = vdup<TYPE>(FACTOR * 2);
-		auto pc = vmask(vdup<TYPE>(VALUE(FACTOR) / VALUE(2)));
-		auto nc = vmask(vdup<TYPE>(-VALUE(FACTOR) / VALUE(2)));
-		pc = vand(pc, vand(vcgt(factor2, apb), vcgt(amb, apb2)));
-		nc = vand(nc, vand(vcgt(factor2, amb), vcgt(apb, amb2)));
-		return vreinterpret<TYPE>(vorr(pc, nc));
+		TYPE mags[cnt];
+		for (int i = 0; i < cnt; ++i)
+			mags[i] = vabs(links[i]);
+
+		// per lane the LAMBDA+1 smallest magnitudes in ascending order
+		TYPE mins[LAMBDA+1];
+		for (int l = 0; l <= LAMBDA; ++l)
+			mins[l] = vdup<TYPE>(14.5f);
+		for (int i = 0; i < cnt; ++i) {
+			TYPE m = mags[i];
+			for (int l = 0; l <= LAMBDA; ++l) {
+				TYPE t = vmin(mins[l], m);
+				m = vmax(mins[l], m);
+				mins[l] = t;
+			}
+		}
+
+		TYPE phis[LAMBDA+1];
+		for (int l = 0; l <= LAMBDA; ++l)
+			phis[l] = phi(mins[l]);
+		TYPE total = phis[0];
+		for (int l = 1; l < LAMBDA; ++l)
+			total = vadd(total, phis[l]);
+
+		TYPE signs[cnt];
+		CODE::exclusive_reduce(links, signs, cnt, sign);
+
+		// a link among the LAMBDA smallest gets replaced by the next one
+		for (int i = 0; i < cnt; ++i) {
+			TYPE sum = total;
+			for (int l = 0; l < LAMBDA; ++l)
+				sum = vreinterpret<TYPE>(vbsl(vceq(mags[i], mins[l]), vmask(vadd(vsub(total, phis[l]), phis[LAMBDA])), vmask(sum)));
+			links[i] = sign(phi(sum), signs[i]);
+		}
 	}
-	static TYPE minc(TYPE a, TYPE b)
+	static bool bad(TYPE v, int blocks)
 	{
-		TYPE m = vmin(vqabs(a), vqabs(b));
-		TYPE x = vsign(vsign(m, a), b);
-		x = vqadd(x, correction_factor(a, b));
-		return x;
+		return bad_lanes(v, blocks);
+	}
+	static void update(TYPE *a, TYPE b)
+	{
+		UPDATE::update(a, b);
+	}
+};
+
+template <int WIDTH, typename UPDATE>
+struct SumProductAlgorithm<SIMD<float, WIDTH>, UPDATE>
+{
+	typedef SIMD<float, WIDTH> TYPE;
+	static TYPE zero()
+	{
+		return vzero<TYPE>();
+	}
+	static TYPE one()
+	{
+		return vdup<TYPE>(1);
+	}
+	// same as 2*atanh(tanh(a/2)*tanh(b/2)), but without the divisions
+	static TYPE boxplus(TYPE a, TYPE b)
+	{
+		TYPE m = vsign(vsign(vmin(vabs(a), vabs(b)), a), b);
+		TYPE p = vlog(vadd(vdup<TYPE>(1), vexp(vneg(vabs(vadd(a, b))))));
+		TYPE n = vlog(vadd(vdup<TYPE>(1), vexp(vneg(vabs(vsub(a, b))))));
+		return vadd(m, vsub(p, n));
+	}
+	static TYPE sign(TYPE a, TYPE b)
+	{
+		return vsign(a, b);
 	}
 	static void finalp(TYPE *links, int cnt)
 	{
 		TYPE tmp[cnt];
-		CODE::exclusive_reduce(links, tmp, cnt, minc);
+		CODE::exclusive_reduce(links, tmp, cnt, boxplus);
 		for (int i = 0; i < cnt; ++i)
 			links[i] = tmp[i];
 	}
 	static TYPE add(TYPE a, TYPE b)
 	{
-		return vqadd(a, b);
+		return vadd(a, b);
 	}
 	static TYPE sub(TYPE a, TYPE b)
 	{
-		return vqsub(a, b);
+		return vsub(a, b);
 	}
 	static bool bad(TYPE v, int blocks)
 	{
-		auto tmp = vcgtz(v);
-		for (int i = 0; i < blocks; ++i)
-			if (!tmp.v[i])
-				return true;
-		return false;
+		return bad_lanes(v, blocks);
 	}
 	static void update(TYPE *a, TYPE b)
 	{
-		UPDATE::update(a, vmin(vmax(b, vdup<TYPE>(-32)), vdup<TYPE>(31)));
+		UPDATE::update(a, b);
 	}
 };
 
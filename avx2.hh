@@ -470,6 +470,14 @@ inline SIMD<double, 4> vmul(SIMD<double, 4> a, SIMD<double, 4> b)
 	return tmp;
 }
 
+template <>
+inline SIMD<float, 8> vneg(SIMD<float, 8> a)
+{
+	SIMD<float, 8> tmp;
+	tmp.m = _mm256_xor_ps(_mm256_set1_ps(-0.f), a.m);
+	return tmp;
+}
+
 template <>
 inline SIMD<float, 8> vabs(SIMD<float, 8> a)
 {
@@ -1188,3 +1196,86 @@ inline SIMD<float, 8> vshuf(SIMD<float, 8> a, SIMD<uint32_t, 8> b)
 	return tmp;
 }
 
+template <>
+inline SIMD<int32_t, 8> vcvtn(SIMD<float, 8> a)
+{
+	SIMD<int32_t, 8> tmp;
+	tmp.m = _mm256_cvtps_epi32(a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 8> vcvt(SIMD<int32_t, 8> a)
+{
+	SIMD<float, 8> tmp;
+	tmp.m = _mm256_cvtepi32_ps(a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 16> vqmovn(SIMD<int32_t, 8> a, SIMD<int32_t, 8> b)
+{
+	SIMD<int16_t, 16> tmp;
+	tmp.m = _mm256_permute4x64_epi64(_mm256_packs_epi32(a.m, b.m), 0xd8);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 32> vqmovn(SIMD<int16_t, 16> a, SIMD<int16_t, 16> b)
+{
+	SIMD<int8_t, 32> tmp;
+	tmp.m = _mm256_permute4x64_epi64(_mm256_packs_epi16(a.m, b.m), 0xd8);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 32> vzip1(SIMD<int8_t, 32> a, SIMD<int8_t, 32> b)
+{
+	SIMD<int8_t, 32> tmp;
+	tmp.m = _mm256_permute2x128_si256(_mm256_unpacklo_epi8(a.m, b.m), _mm256_unpackhi_epi8(a.m, b.m), 0x20);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 32> vzip2(SIMD<int8_t, 32> a, SIMD<int8_t, 32> b)
+{
+	SIMD<int8_t, 32> tmp;
+	tmp.m = _mm256_permute2x128_si256(_mm256_unpacklo_epi8(a.m, b.m), _mm256_unpackhi_epi8(a.m, b.m), 0x31);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 16> vzip1(SIMD<int16_t, 16> a, SIMD<int16_t, 16> b)
+{
+	SIMD<int16_t, 16> tmp;
+	tmp.m = _mm256_permute2x128_si256(_mm256_unpacklo_epi16(a.m, b.m), _mm256_unpackhi_epi16(a.m, b.m), 0x20);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 16> vzip2(SIMD<int16_t, 16> a, SIMD<int16_t, 16> b)
+{
+	SIMD<int16_t, 16> tmp;
+	tmp.m = _mm256_permute2x128_si256(_mm256_unpacklo_epi16(a.m, b.m), _mm256_unpackhi_epi16(a.m, b.m), 0x31);
+	return tmp;
+}
+
+template <>
+inline uint64_t vmovemask(SIMD<uint8_t, 32> a)
+{
+	return uint32_t(_mm256_movemask_epi8(a.m));
+}
+
+// packs works within 128 bit lanes, leaving the upper eight masks in bits 16 to 23
+template <>
+inline uint64_t vmovemask(SIMD<uint16_t, 16> a)
+{
+	uint32_t m = _mm256_movemask_epi8(_mm256_packs_epi16(a.m, _mm256_setzero_si256()));
+	return (m & 0xff) | ((m >> 8) & 0xff00);
+}
+
+template <>
+inline uint64_t vmovemask(SIMD<uint32_t, 8> a)
+{
+	return _mm256_movemask_ps(_mm256_castsi256_ps(a.m));
+}
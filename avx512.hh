@@ -0,0 +1,1274 @@
+/*
+Intel AVX-512 acceleration
+
+Copyright 2018 Ahmet Inan <inan@aicodix.de>
+*/
+
+#pragma once
+
+#include <immintrin.h>
+
+template <>
+union SIMD<float, 16>
+{
+	static const int SIZE = 16;
+	typedef float value_type;
+	typedef uint32_t uint_type;
+	__m512 m;
+	value_type v[SIZE];
+	uint_type u[SIZE];
+};
+
+template <>
+union SIMD<double, 8>
+{
+	static const int SIZE = 8;
+	typedef double value_type;
+	typedef uint64_t uint_type;
+	__m512d m;
+	value_type v[SIZE];
+	uint_type u[SIZE];
+};
+
+template <>
+union SIMD<int8_t, 64>
+{
+	static const int SIZE = 64;
+	typedef int8_t value_type;
+	typedef uint8_t uint_type;
+	__m512i m;
+	value_type v[SIZE];
+	uint_type u[SIZE];
+};
+
+template <>
+union SIMD<int16_t, 32>
+{
+	static const int SIZE = 32;
+	typedef int16_t value_type;
+	typedef uint16_t uint_type;
+	__m512i m;
+	value_type v[SIZE];
+	uint_type u[SIZE];
+};
+
+template <>
+union SIMD<int32_t, 16>
+{
+	static const int SIZE = 16;
+	typedef int32_t value_type;
+	typedef uint32_t uint_type;
+	__m512i m;
+	value_type v[SIZE];
+	uint_type u[SIZE];
+};
+
+template <>
+union SIMD<int64_t, 8>
+{
+	static const int SIZE = 8;
+	typedef int64_t value_type;
+	typedef uint64_t uint_type;
+	__m512i m;
+	value_type v[SIZE];
+	uint_type u[SIZE];
+};
+
+template <>
+union SIMD<uint8_t, 64>
+{
+	static const int SIZE = 64;
+	typedef uint8_t value_type;
+	typedef uint8_t uint_type;
+	__m512i m;
+	value_type v[SIZE];
+	uint_type u[SIZE];
+};
+
+template <>
+union SIMD<uint16_t, 32>
+{
+	static const int SIZE = 32;
+	typedef uint16_t value_type;
+	typedef uint16_t uint_type;
+	__m512i m;
+	value_type v[SIZE];
+	uint_type u[SIZE];
+};
+
+template <>
+union SIMD<uint32_t, 16>
+{
+	static const int SIZE = 16;
+	typedef uint32_t value_type;
+	typedef uint32_t uint_type;
+	__m512i m;
+	value_type v[SIZE];
+	uint_type u[SIZE];
+};
+
+template <>
+union SIMD<uint64_t, 8>
+{
+	static const int SIZE = 8;
+	typedef uint64_t value_type;
+	typedef uint64_t uint_type;
+	__m512i m;
+	value_type v[SIZE];
+	uint_type u[SIZE];
+};
+
+template <>
+inline SIMD<float, 16> vreinterpret(SIMD<uint32_t, 16> a)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = (__m512)a.m;
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vreinterpret(SIMD<float, 16> a)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = (__m512i)a.m;
+	return tmp;
+}
+
+template <>
+inline SIMD<double, 8> vreinterpret(SIMD<uint64_t, 8> a)
+{
+	SIMD<double, 8> tmp;
+	tmp.m = (__m512d)a.m;
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vreinterpret(SIMD<double, 8> a)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = (__m512i)a.m;
+	return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vreinterpret(SIMD<int8_t, 64> a)
+{
+	SIMD<uint8_t, 64> tmp;
+	tmp.m = a.m;
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vreinterpret(SIMD<uint8_t, 64> a)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = a.m;
+	return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vreinterpret(SIMD<int16_t, 32> a)
+{
+	SIMD<uint16_t, 32> tmp;
+	tmp.m = a.m;
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vreinterpret(SIMD<uint16_t, 32> a)
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = a.m;
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vreinterpret(SIMD<int32_t, 16> a)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = a.m;
+	return tmp;
+}
+
+template <>
+inline SIMD<int32_t, 16> vreinterpret(SIMD<uint32_t, 16> a)
+{
+	SIMD<int32_t, 16> tmp;
+	tmp.m = a.m;
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vreinterpret(SIMD<int64_t, 8> a)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = a.m;
+	return tmp;
+}
+
+template <>
+inline SIMD<int64_t, 8> vreinterpret(SIMD<uint64_t, 8> a)
+{
+	SIMD<int64_t, 8> tmp;
+	tmp.m = a.m;
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vdup<SIMD<float, 16>>(float a)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = _mm512_set1_ps(a);
+	return tmp;
+}
+
+template <>
+inline SIMD<double, 8> vdup<SIMD<double, 8>>(double a)
+{
+	SIMD<double, 8> tmp;
+	tmp.m = _mm512_set1_pd(a);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vdup<SIMD<int8_t, 64>>(int8_t a)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_set1_epi8(a);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vdup<SIMD<int16_t, 32>>(int16_t a)
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = _mm512_set1_epi16(a);
+	return tmp;
+}
+
+template <>
+inline SIMD<int32_t, 16> vdup<SIMD<int32_t, 16>>(int32_t a)
+{
+	SIMD<int32_t, 16> tmp;
+	tmp.m = _mm512_set1_epi32(a);
+	return tmp;
+}
+
+template <>
+inline SIMD<int64_t, 8> vdup<SIMD<int64_t, 8>>(int64_t a)
+{
+	SIMD<int64_t, 8> tmp;
+	tmp.m = _mm512_set1_epi64(a);
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vzero()
+{
+	SIMD<float, 16> tmp;
+	tmp.m = _mm512_setzero_ps();
+	return tmp;
+}
+
+template <>
+inline SIMD<double, 8> vzero()
+{
+	SIMD<double, 8> tmp;
+	tmp.m = _mm512_setzero_pd();
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vzero()
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_setzero_si512();
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vzero()
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = _mm512_setzero_si512();
+	return tmp;
+}
+
+template <>
+inline SIMD<int32_t, 16> vzero()
+{
+	SIMD<int32_t, 16> tmp;
+	tmp.m = _mm512_setzero_si512();
+	return tmp;
+}
+
+template <>
+inline SIMD<int64_t, 8> vzero()
+{
+	SIMD<int64_t, 8> tmp;
+	tmp.m = _mm512_setzero_si512();
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vadd(SIMD<float, 16> a, SIMD<float, 16> b)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = _mm512_add_ps(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<double, 8> vadd(SIMD<double, 8> a, SIMD<double, 8> b)
+{
+	SIMD<double, 8> tmp;
+	tmp.m = _mm512_add_pd(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vadd(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_add_epi8(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vadd(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = _mm512_add_epi16(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int32_t, 16> vadd(SIMD<int32_t, 16> a, SIMD<int32_t, 16> b)
+{
+	SIMD<int32_t, 16> tmp;
+	tmp.m = _mm512_add_epi32(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int64_t, 8> vadd(SIMD<int64_t, 8> a, SIMD<int64_t, 8> b)
+{
+	SIMD<int64_t, 8> tmp;
+	tmp.m = _mm512_add_epi64(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vqadd(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_adds_epi8(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vqadd(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = _mm512_adds_epi16(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vsub(SIMD<float, 16> a, SIMD<float, 16> b)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = _mm512_sub_ps(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<double, 8> vsub(SIMD<double, 8> a, SIMD<double, 8> b)
+{
+	SIMD<double, 8> tmp;
+	tmp.m = _mm512_sub_pd(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vsub(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_sub_epi8(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vsub(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = _mm512_sub_epi16(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int32_t, 16> vsub(SIMD<int32_t, 16> a, SIMD<int32_t, 16> b)
+{
+	SIMD<int32_t, 16> tmp;
+	tmp.m = _mm512_sub_epi32(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int64_t, 8> vsub(SIMD<int64_t, 8> a, SIMD<int64_t, 8> b)
+{
+	SIMD<int64_t, 8> tmp;
+	tmp.m = _mm512_sub_epi64(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vqsub(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_subs_epi8(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vqsub(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = _mm512_subs_epi16(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vqsub(SIMD<uint8_t, 64> a, SIMD<uint8_t, 64> b)
+{
+	SIMD<uint8_t, 64> tmp;
+	tmp.m = _mm512_subs_epu8(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vqsub(SIMD<uint16_t, 32> a, SIMD<uint16_t, 32> b)
+{
+	SIMD<uint16_t, 32> tmp;
+	tmp.m = _mm512_subs_epu16(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vmul(SIMD<float, 16> a, SIMD<float, 16> b)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = _mm512_mul_ps(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<double, 8> vmul(SIMD<double, 8> a, SIMD<double, 8> b)
+{
+	SIMD<double, 8> tmp;
+	tmp.m = _mm512_mul_pd(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vneg(SIMD<float, 16> a)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = (__m512)_mm512_xor_si512((__m512i)_mm512_set1_ps(-0.f), (__m512i)a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vabs(SIMD<float, 16> a)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = _mm512_abs_ps(a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<double, 8> vabs(SIMD<double, 8> a)
+{
+	SIMD<double, 8> tmp;
+	tmp.m = _mm512_abs_pd(a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vqabs(SIMD<int8_t, 64> a)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_abs_epi8(_mm512_max_epi8(a.m, _mm512_set1_epi8(-INT8_MAX)));
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vqabs(SIMD<int16_t, 32> a)
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = _mm512_abs_epi16(_mm512_max_epi16(a.m, _mm512_set1_epi16(-INT16_MAX)));
+	return tmp;
+}
+
+template <>
+inline SIMD<int32_t, 16> vqabs(SIMD<int32_t, 16> a)
+{
+	SIMD<int32_t, 16> tmp;
+	tmp.m = _mm512_abs_epi32(_mm512_max_epi32(a.m, _mm512_set1_epi32(-INT32_MAX)));
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vsignum(SIMD<float, 16> a)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = _mm512_maskz_mov_ps(
+		_mm512_cmp_ps_mask(a.m, _mm512_setzero_ps(), _CMP_NEQ_UQ),
+		(__m512)_mm512_or_si512((__m512i)_mm512_set1_ps(1.f), _mm512_and_si512((__m512i)_mm512_set1_ps(-0.f), (__m512i)a.m)));
+	return tmp;
+}
+
+template <>
+inline SIMD<double, 8> vsignum(SIMD<double, 8> a)
+{
+	SIMD<double, 8> tmp;
+	tmp.m = _mm512_maskz_mov_pd(
+		_mm512_cmp_pd_mask(a.m, _mm512_setzero_pd(), _CMP_NEQ_UQ),
+		(__m512d)_mm512_or_si512((__m512i)_mm512_set1_pd(1.), _mm512_and_si512((__m512i)_mm512_set1_pd(-0.), (__m512i)a.m)));
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vsignum(SIMD<int8_t, 64> a)
+{
+	SIMD<int8_t, 64> tmp;
+	__m512i zero = _mm512_setzero_si512();
+	__m512i one = _mm512_set1_epi8(1);
+	tmp.m = _mm512_mask_sub_epi8(_mm512_maskz_mov_epi8(_mm512_cmpgt_epi8_mask(a.m, zero), one), _mm512_cmplt_epi8_mask(a.m, zero), zero, one);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vsignum(SIMD<int16_t, 32> a)
+{
+	SIMD<int16_t, 32> tmp;
+	__m512i zero = _mm512_setzero_si512();
+	__m512i one = _mm512_set1_epi16(1);
+	tmp.m = _mm512_mask_sub_epi16(_mm512_maskz_mov_epi16(_mm512_cmpgt_epi16_mask(a.m, zero), one), _mm512_cmplt_epi16_mask(a.m, zero), zero, one);
+	return tmp;
+}
+
+template <>
+inline SIMD<int32_t, 16> vsignum(SIMD<int32_t, 16> a)
+{
+	SIMD<int32_t, 16> tmp;
+	__m512i zero = _mm512_setzero_si512();
+	__m512i one = _mm512_set1_epi32(1);
+	tmp.m = _mm512_mask_sub_epi32(_mm512_maskz_mov_epi32(_mm512_cmpgt_epi32_mask(a.m, zero), one), _mm512_cmplt_epi32_mask(a.m, zero), zero, one);
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vsign(SIMD<float, 16> a, SIMD<float, 16> b)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = _mm512_maskz_mov_ps(
+		_mm512_cmp_ps_mask(b.m, _mm512_setzero_ps(), _CMP_NEQ_UQ),
+		(__m512)_mm512_xor_si512((__m512i)a.m, _mm512_and_si512((__m512i)_mm512_set1_ps(-0.f), (__m512i)b.m)));
+	return tmp;
+}
+
+template <>
+inline SIMD<double, 8> vsign(SIMD<double, 8> a, SIMD<double, 8> b)
+{
+	SIMD<double, 8> tmp;
+	tmp.m = _mm512_maskz_mov_pd(
+		_mm512_cmp_pd_mask(b.m, _mm512_setzero_pd(), _CMP_NEQ_UQ),
+		(__m512d)_mm512_xor_si512((__m512i)a.m, _mm512_and_si512((__m512i)_mm512_set1_pd(-0.), (__m512i)b.m)));
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vsign(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+	SIMD<int8_t, 64> tmp;
+	__m512i zero = _mm512_setzero_si512();
+	tmp.m = _mm512_mask_sub_epi8(_mm512_maskz_mov_epi8(_mm512_cmpneq_epi8_mask(b.m, zero), a.m), _mm512_cmplt_epi8_mask(b.m, zero), zero, a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vsign(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+	SIMD<int16_t, 32> tmp;
+	__m512i zero = _mm512_setzero_si512();
+	tmp.m = _mm512_mask_sub_epi16(_mm512_maskz_mov_epi16(_mm512_cmpneq_epi16_mask(b.m, zero), a.m), _mm512_cmplt_epi16_mask(b.m, zero), zero, a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int32_t, 16> vsign(SIMD<int32_t, 16> a, SIMD<int32_t, 16> b)
+{
+	SIMD<int32_t, 16> tmp;
+	__m512i zero = _mm512_setzero_si512();
+	tmp.m = _mm512_mask_sub_epi32(_mm512_maskz_mov_epi32(_mm512_cmpneq_epi32_mask(b.m, zero), a.m), _mm512_cmplt_epi32_mask(b.m, zero), zero, a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vcopysign(SIMD<float, 16> a, SIMD<float, 16> b)
+{
+	SIMD<float, 16> tmp;
+	__m512i negz = (__m512i)_mm512_set1_ps(-0.f);
+	tmp.m = (__m512)_mm512_or_si512(
+		_mm512_andnot_si512(negz, (__m512i)a.m),
+		_mm512_and_si512(negz, (__m512i)b.m));
+	return tmp;
+}
+
+template <>
+inline SIMD<double, 8> vcopysign(SIMD<double, 8> a, SIMD<double, 8> b)
+{
+	SIMD<double, 8> tmp;
+	__m512i negz = (__m512i)_mm512_set1_pd(-0.);
+	tmp.m = (__m512d)_mm512_or_si512(
+		_mm512_andnot_si512(negz, (__m512i)a.m),
+		_mm512_and_si512(negz, (__m512i)b.m));
+	return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vorr(SIMD<uint8_t, 64> a, SIMD<uint8_t, 64> b)
+{
+	SIMD<uint8_t, 64> tmp;
+	tmp.m = _mm512_or_si512(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vorr(SIMD<uint16_t, 32> a, SIMD<uint16_t, 32> b)
+{
+	SIMD<uint16_t, 32> tmp;
+	tmp.m = _mm512_or_si512(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vorr(SIMD<uint32_t, 16> a, SIMD<uint32_t, 16> b)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_or_si512(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vorr(SIMD<uint64_t, 8> a, SIMD<uint64_t, 8> b)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_or_si512(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vand(SIMD<uint8_t, 64> a, SIMD<uint8_t, 64> b)
+{
+	SIMD<uint8_t, 64> tmp;
+	tmp.m = _mm512_and_si512(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vand(SIMD<uint16_t, 32> a, SIMD<uint16_t, 32> b)
+{
+	SIMD<uint16_t, 32> tmp;
+	tmp.m = _mm512_and_si512(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vand(SIMD<uint32_t, 16> a, SIMD<uint32_t, 16> b)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_and_si512(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vand(SIMD<uint64_t, 8> a, SIMD<uint64_t, 8> b)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_and_si512(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> veor(SIMD<uint8_t, 64> a, SIMD<uint8_t, 64> b)
+{
+	SIMD<uint8_t, 64> tmp;
+	tmp.m = _mm512_xor_si512(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> veor(SIMD<uint16_t, 32> a, SIMD<uint16_t, 32> b)
+{
+	SIMD<uint16_t, 32> tmp;
+	tmp.m = _mm512_xor_si512(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> veor(SIMD<uint32_t, 16> a, SIMD<uint32_t, 16> b)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_xor_si512(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> veor(SIMD<uint64_t, 8> a, SIMD<uint64_t, 8> b)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_xor_si512(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vbic(SIMD<uint8_t, 64> a, SIMD<uint8_t, 64> b)
+{
+	SIMD<uint8_t, 64> tmp;
+	tmp.m = _mm512_andnot_si512(b.m, a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vbic(SIMD<uint16_t, 32> a, SIMD<uint16_t, 32> b)
+{
+	SIMD<uint16_t, 32> tmp;
+	tmp.m = _mm512_andnot_si512(b.m, a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vbic(SIMD<uint32_t, 16> a, SIMD<uint32_t, 16> b)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_andnot_si512(b.m, a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vbic(SIMD<uint64_t, 8> a, SIMD<uint64_t, 8> b)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_andnot_si512(b.m, a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vbsl(SIMD<uint8_t, 64> a, SIMD<uint8_t, 64> b, SIMD<uint8_t, 64> c)
+{
+	SIMD<uint8_t, 64> tmp;
+	tmp.m = _mm512_ternarylogic_epi32(a.m, b.m, c.m, 0xca);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vbsl(SIMD<uint16_t, 32> a, SIMD<uint16_t, 32> b, SIMD<uint16_t, 32> c)
+{
+	SIMD<uint16_t, 32> tmp;
+	tmp.m = _mm512_ternarylogic_epi32(a.m, b.m, c.m, 0xca);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vbsl(SIMD<uint32_t, 16> a, SIMD<uint32_t, 16> b, SIMD<uint32_t, 16> c)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_ternarylogic_epi32(a.m, b.m, c.m, 0xca);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vbsl(SIMD<uint64_t, 8> a, SIMD<uint64_t, 8> b, SIMD<uint64_t, 8> c)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_ternarylogic_epi32(a.m, b.m, c.m, 0xca);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vceqz(SIMD<float, 16> a)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_maskz_set1_epi32(_mm512_cmp_ps_mask(a.m, _mm512_setzero_ps(), _CMP_EQ_OQ), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vceqz(SIMD<double, 8> a)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(a.m, _mm512_setzero_pd(), _CMP_EQ_OQ), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vceqz(SIMD<int8_t, 64> a)
+{
+	SIMD<uint8_t, 64> tmp;
+	tmp.m = _mm512_movm_epi8(_mm512_cmpeq_epi8_mask(a.m, _mm512_setzero_si512()));
+	return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vceqz(SIMD<int16_t, 32> a)
+{
+	SIMD<uint16_t, 32> tmp;
+	tmp.m = _mm512_movm_epi16(_mm512_cmpeq_epi16_mask(a.m, _mm512_setzero_si512()));
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vceqz(SIMD<int32_t, 16> a)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_maskz_set1_epi32(_mm512_cmpeq_epi32_mask(a.m, _mm512_setzero_si512()), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vceqz(SIMD<int64_t, 8> a)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_maskz_set1_epi64(_mm512_cmpeq_epi64_mask(a.m, _mm512_setzero_si512()), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vceq(SIMD<float, 16> a, SIMD<float, 16> b)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_maskz_set1_epi32(_mm512_cmp_ps_mask(a.m, b.m, _CMP_EQ_OQ), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vceq(SIMD<double, 8> a, SIMD<double, 8> b)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(a.m, b.m, _CMP_EQ_OQ), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vceq(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+	SIMD<uint8_t, 64> tmp;
+	tmp.m = _mm512_movm_epi8(_mm512_cmpeq_epi8_mask(a.m, b.m));
+	return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vceq(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+	SIMD<uint16_t, 32> tmp;
+	tmp.m = _mm512_movm_epi16(_mm512_cmpeq_epi16_mask(a.m, b.m));
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vceq(SIMD<int32_t, 16> a, SIMD<int32_t, 16> b)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_maskz_set1_epi32(_mm512_cmpeq_epi32_mask(a.m, b.m), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vceq(SIMD<int64_t, 8> a, SIMD<int64_t, 8> b)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_maskz_set1_epi64(_mm512_cmpeq_epi64_mask(a.m, b.m), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vcgtz(SIMD<float, 16> a)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_maskz_set1_epi32(_mm512_cmp_ps_mask(a.m, _mm512_setzero_ps(), _CMP_GT_OQ), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vcgtz(SIMD<double, 8> a)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(a.m, _mm512_setzero_pd(), _CMP_GT_OQ), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vcgtz(SIMD<int8_t, 64> a)
+{
+	SIMD<uint8_t, 64> tmp;
+	tmp.m = _mm512_movm_epi8(_mm512_cmpgt_epi8_mask(a.m, _mm512_setzero_si512()));
+	return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vcgtz(SIMD<int16_t, 32> a)
+{
+	SIMD<uint16_t, 32> tmp;
+	tmp.m = _mm512_movm_epi16(_mm512_cmpgt_epi16_mask(a.m, _mm512_setzero_si512()));
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vcgtz(SIMD<int32_t, 16> a)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_maskz_set1_epi32(_mm512_cmpgt_epi32_mask(a.m, _mm512_setzero_si512()), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vcgtz(SIMD<int64_t, 8> a)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_maskz_set1_epi64(_mm512_cmpgt_epi64_mask(a.m, _mm512_setzero_si512()), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vcltz(SIMD<float, 16> a)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_maskz_set1_epi32(_mm512_cmp_ps_mask(a.m, _mm512_setzero_ps(), _CMP_LT_OQ), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vcltz(SIMD<double, 8> a)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(a.m, _mm512_setzero_pd(), _CMP_LT_OQ), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vcltz(SIMD<int8_t, 64> a)
+{
+	SIMD<uint8_t, 64> tmp;
+	tmp.m = _mm512_movm_epi8(_mm512_cmplt_epi8_mask(a.m, _mm512_setzero_si512()));
+	return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vcltz(SIMD<int16_t, 32> a)
+{
+	SIMD<uint16_t, 32> tmp;
+	tmp.m = _mm512_movm_epi16(_mm512_cmplt_epi16_mask(a.m, _mm512_setzero_si512()));
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vcltz(SIMD<int32_t, 16> a)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_maskz_set1_epi32(_mm512_cmplt_epi32_mask(a.m, _mm512_setzero_si512()), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vcltz(SIMD<int64_t, 8> a)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_maskz_set1_epi64(_mm512_cmplt_epi64_mask(a.m, _mm512_setzero_si512()), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vclez(SIMD<float, 16> a)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_maskz_set1_epi32(_mm512_cmp_ps_mask(a.m, _mm512_setzero_ps(), _CMP_LE_OQ), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vclez(SIMD<double, 8> a)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_maskz_set1_epi64(_mm512_cmp_pd_mask(a.m, _mm512_setzero_pd(), _CMP_LE_OQ), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint8_t, 64> vclez(SIMD<int8_t, 64> a)
+{
+	SIMD<uint8_t, 64> tmp;
+	tmp.m = _mm512_movm_epi8(_mm512_cmple_epi8_mask(a.m, _mm512_setzero_si512()));
+	return tmp;
+}
+
+template <>
+inline SIMD<uint16_t, 32> vclez(SIMD<int16_t, 32> a)
+{
+	SIMD<uint16_t, 32> tmp;
+	tmp.m = _mm512_movm_epi16(_mm512_cmple_epi16_mask(a.m, _mm512_setzero_si512()));
+	return tmp;
+}
+
+template <>
+inline SIMD<uint32_t, 16> vclez(SIMD<int32_t, 16> a)
+{
+	SIMD<uint32_t, 16> tmp;
+	tmp.m = _mm512_maskz_set1_epi32(_mm512_cmple_epi32_mask(a.m, _mm512_setzero_si512()), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<uint64_t, 8> vclez(SIMD<int64_t, 8> a)
+{
+	SIMD<uint64_t, 8> tmp;
+	tmp.m = _mm512_maskz_set1_epi64(_mm512_cmple_epi64_mask(a.m, _mm512_setzero_si512()), -1);
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vmin(SIMD<float, 16> a, SIMD<float, 16> b)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = _mm512_min_ps(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<double, 8> vmin(SIMD<double, 8> a, SIMD<double, 8> b)
+{
+	SIMD<double, 8> tmp;
+	tmp.m = _mm512_min_pd(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vmin(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_min_epi8(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vmin(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = _mm512_min_epi16(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int32_t, 16> vmin(SIMD<int32_t, 16> a, SIMD<int32_t, 16> b)
+{
+	SIMD<int32_t, 16> tmp;
+	tmp.m = _mm512_min_epi32(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vmax(SIMD<float, 16> a, SIMD<float, 16> b)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = _mm512_max_ps(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<double, 8> vmax(SIMD<double, 8> a, SIMD<double, 8> b)
+{
+	SIMD<double, 8> tmp;
+	tmp.m = _mm512_max_pd(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vmax(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_max_epi8(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vmax(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = _mm512_max_epi16(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int32_t, 16> vmax(SIMD<int32_t, 16> a, SIMD<int32_t, 16> b)
+{
+	SIMD<int32_t, 16> tmp;
+	tmp.m = _mm512_max_epi32(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vclamp(SIMD<float, 16> x, float a, float b)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = _mm512_min_ps(_mm512_max_ps(x.m, _mm512_set1_ps(a)), _mm512_set1_ps(b));
+	return tmp;
+}
+
+template <>
+inline SIMD<double, 8> vclamp(SIMD<double, 8> x, double a, double b)
+{
+	SIMD<double, 8> tmp;
+	tmp.m = _mm512_min_pd(_mm512_max_pd(x.m, _mm512_set1_pd(a)), _mm512_set1_pd(b));
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vclamp(SIMD<int8_t, 64> x, int8_t a, int8_t b)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_min_epi8(_mm512_max_epi8(x.m, _mm512_set1_epi8(a)), _mm512_set1_epi8(b));
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vclamp(SIMD<int16_t, 32> x, int16_t a, int16_t b)
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = _mm512_min_epi16(_mm512_max_epi16(x.m, _mm512_set1_epi16(a)), _mm512_set1_epi16(b));
+	return tmp;
+}
+
+template <>
+inline SIMD<int32_t, 16> vclamp(SIMD<int32_t, 16> x, int32_t a, int32_t b)
+{
+	SIMD<int32_t, 16> tmp;
+	tmp.m = _mm512_min_epi32(_mm512_max_epi32(x.m, _mm512_set1_epi32(a)), _mm512_set1_epi32(b));
+	return tmp;
+}
+
+template <>
+inline SIMD<int64_t, 8> vclamp(SIMD<int64_t, 8> x, int64_t a, int64_t b)
+{
+	SIMD<int64_t, 8> tmp;
+	tmp.m = _mm512_min_epi64(_mm512_max_epi64(x.m, _mm512_set1_epi64(a)), _mm512_set1_epi64(b));
+	return tmp;
+}
+
+#ifdef __AVX512VBMI__
+template <>
+inline SIMD<uint8_t, 64> vshuf(SIMD<uint8_t, 64> a, SIMD<uint8_t, 64> b)
+{
+	SIMD<uint8_t, 64> tmp;
+	tmp.m = _mm512_maskz_permutexvar_epi8(_mm512_cmplt_epu8_mask(b.m, _mm512_set1_epi8(64)), b.m, a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vshuf(SIMD<int8_t, 64> a, SIMD<uint8_t, 64> b)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_maskz_permutexvar_epi8(_mm512_cmplt_epu8_mask(b.m, _mm512_set1_epi8(64)), b.m, a.m);
+	return tmp;
+}
+#endif
+
+template <>
+inline SIMD<float, 16> vshuf(SIMD<float, 16> a, SIMD<uint32_t, 16> b)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = _mm512_maskz_permutexvar_ps(_mm512_cmplt_epu32_mask(b.m, _mm512_set1_epi32(16)), b.m, a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int32_t, 16> vcvtn(SIMD<float, 16> a)
+{
+	SIMD<int32_t, 16> tmp;
+	tmp.m = _mm512_cvtps_epi32(a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 16> vcvt(SIMD<int32_t, 16> a)
+{
+	SIMD<float, 16> tmp;
+	tmp.m = _mm512_cvtepi32_ps(a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vqmovn(SIMD<int32_t, 16> a, SIMD<int32_t, 16> b)
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7), _mm512_packs_epi32(a.m, b.m));
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vqmovn(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_permutexvar_epi64(_mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7), _mm512_packs_epi16(a.m, b.m));
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vzip1(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_permutex2var_epi64(_mm512_unpacklo_epi8(a.m, b.m), _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11), _mm512_unpackhi_epi8(a.m, b.m));
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 64> vzip2(SIMD<int8_t, 64> a, SIMD<int8_t, 64> b)
+{
+	SIMD<int8_t, 64> tmp;
+	tmp.m = _mm512_permutex2var_epi64(_mm512_unpacklo_epi8(a.m, b.m), _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15), _mm512_unpackhi_epi8(a.m, b.m));
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vzip1(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = _mm512_permutex2var_epi64(_mm512_unpacklo_epi16(a.m, b.m), _mm512_setr_epi64(0, 1, 8, 9, 2, 3, 10, 11), _mm512_unpackhi_epi16(a.m, b.m));
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 32> vzip2(SIMD<int16_t, 32> a, SIMD<int16_t, 32> b)
+{
+	SIMD<int16_t, 32> tmp;
+	tmp.m = _mm512_permutex2var_epi64(_mm512_unpacklo_epi16(a.m, b.m), _mm512_setr_epi64(4, 5, 12, 13, 6, 7, 14, 15), _mm512_unpackhi_epi16(a.m, b.m));
+	return tmp;
+}
+
+template <>
+inline uint64_t vmovemask(SIMD<uint8_t, 64> a)
+{
+	return _mm512_movepi8_mask(a.m);
+}
+
+template <>
+inline uint64_t vmovemask(SIMD<uint16_t, 32> a)
+{
+	return _mm512_movepi16_mask(a.m);
+}
+
+template <>
+inline uint64_t vmovemask(SIMD<uint32_t, 16> a)
+{
+	return _mm512_cmplt_epi32_mask(a.m, _mm512_setzero_si512());
+}
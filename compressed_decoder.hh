@@ -0,0 +1,152 @@
+/*
+LDPC SISO layered decoder with compressed check node states
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#ifndef COMPRESSED_DECODER_HH
+#define COMPRESSED_DECODER_HH
+
+#include <type_traits>
+#include "ldpc.hh"
+
+template <typename TYPE, typename ALG>
+class LDPCDecoder
+{
+	// the states only hold the new messages, there is no old one left to correct against
+	static_assert(std::is_same<typename ALG::update_type, NormalUpdate<TYPE>>::value, "compressed check node states do not support the self-corrected update");
+	static_assert(sizeof(typename TYPE::value_type) == 1, "compressed check node states are packed into bytes");
+	TYPE *cns, *pty;
+	const uint16_t *pos;
+	const uint8_t *cnc;
+	ALG alg;
+	int M, N, K, R, q, CNL, ST, CNS, PTY;
+	bool initialized;
+
+	void reset()
+	{
+		for (int i = 0; i < ST; ++i)
+			cns[i] = alg.zero();
+	}
+	// a lane of acc stays positive only while all checks of the row group are satisfied
+	bool bad(TYPE *data, TYPE *parity, int blocks)
+	{
+		for (int i = 0; i < q; ++i) {
+			int cnt = cnc[i];
+			TYPE acc = alg.one();
+			for (int j = 0; j < M; ++j) {
+				TYPE cnv = alg.sign(alg.one(), parity[M*i+j]);
+				if (i)
+					cnv = alg.sign(cnv, parity[M*(i-1)+j]);
+				else if (j)
+					cnv = alg.sign(cnv, parity[j+(q-1)*M-1]);
+				for (int c = 0; c < cnt; ++c)
+					cnv = alg.sign(cnv, data[pos[CNL*(M*i+j)+c]]);
+				acc = alg.sign(alg.sign(acc, alg.add(cnv, alg.one())), cnv);
+			}
+			if (alg.bad(acc, blocks))
+				return true;
+		}
+		return false;
+	}
+	void update(TYPE *data, TYPE *parity)
+	{
+		TYPE *cs = cns;
+		for (int i = 0; i < q; ++i) {
+			int cnt = cnc[i];
+			int num = alg.states(cnt + 2);
+			for (int j = 0; j < M; ++j) {
+				int deg = cnt + 2 - !(i|j);
+				TYPE msg[deg], inp[deg], out[deg];
+				alg.messages(msg, cs, deg);
+				for (int c = 0; c < cnt; ++c)
+					inp[c] = out[c] = alg.sub(data[pos[CNL*(M*i+j)+c]], msg[c]);
+				inp[cnt] = out[cnt] = alg.sub(parity[M*i+j], msg[cnt]);
+				if (i)
+					inp[cnt+1] = out[cnt+1] = alg.sub(parity[M*(i-1)+j], msg[cnt+1]);
+				else if (j)
+					inp[cnt+1] = out[cnt+1] = alg.sub(parity[j+(q-1)*M-1], msg[cnt+1]);
+				alg.finalc(cs, out, deg);
+				for (int c = 0; c < cnt; ++c)
+					data[pos[CNL*(M*i+j)+c]] = alg.add(inp[c], out[c]);
+				parity[M*i+j] = alg.add(inp[cnt], out[cnt]);
+				if (i)
+					parity[M*(i-1)+j] = alg.add(inp[cnt+1], out[cnt+1]);
+				else if (j)
+					parity[j+(q-1)*M-1] = alg.add(inp[cnt+1], out[cnt+1]);
+				cs += num;
+			}
+		}
+	}
+	// buffers only grow, so switching back and forth between codes does not allocate
+	void grow()
+	{
+		if (!initialized || CNS < ST) {
+			if (initialized)
+				delete[] cns;
+			CNS = ST;
+			cns = new TYPE[CNS];
+		}
+		if (!initialized || PTY < R) {
+			if (initialized)
+				delete[] pty;
+			PTY = R;
+			pty = new TYPE[PTY];
+		}
+		initialized = true;
+	}
+public:
+	LDPCDecoder() : initialized(false)
+	{
+	}
+	void init(LDPCInterface *it)
+	{
+		N = it->code_len();
+		K = it->data_len();
+		M = it->group_len();
+		R = N - K;
+		q = R / M;
+		CNL = it->links_max_cn() - 2;
+		pos = it->layered_pos();
+		cnc = it->check_degs();
+		ST = 0;
+		for (int i = 0; i < q; ++i)
+			ST += M * alg.states(cnc[i] + 2);
+		grow();
+	}
+	void init(const LDPCDecoder *dec)
+	{
+		N = dec->N;
+		K = dec->K;
+		M = dec->M;
+		R = dec->R;
+		q = dec->q;
+		CNL = dec->CNL;
+		ST = dec->ST;
+		pos = dec->pos;
+		cnc = dec->cnc;
+		grow();
+	}
+	int operator()(TYPE *data, TYPE *parity, int trials = 25, int blocks = 1)
+	{
+		reset();
+		for (int i = 0; i < q; ++i)
+			for (int j = 0; j < M; ++j)
+				pty[M*i+j] = parity[q*j+i];
+		while (bad(data, pty, blocks) && --trials >= 0)
+			update(data, pty);
+		for (int i = 0; i < q; ++i)
+			for (int j = 0; j < M; ++j)
+				parity[q*j+i] = pty[M*i+j];
+		return trials;
+	}
+	~LDPCDecoder()
+	{
+		if (initialized) {
+			delete[] cns;
+			delete[] pty;
+		}
+	}
+};
+
+#endif
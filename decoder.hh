@@ -0,0 +1,22 @@
+/*
+LDPC decoder interface
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#ifndef DECODER_HH
+#define DECODER_HH
+
+#include <cstdint>
+#include "ldpc.hh"
+
+struct DecoderInterface
+{
+	virtual const char *name() = 0;
+	virtual int width() = 0;
+	virtual void init(LDPCInterface *) = 0;
+	virtual int operator()(int8_t *, int, int) = 0;
+	virtual ~DecoderInterface() = default;
+};
+
+#endif
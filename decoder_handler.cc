@@ -0,0 +1,120 @@
+/*
+LDPC decoders handler
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <complex>
+#include <mutex>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#include "ldpc.hh"
+#include "decoder.hh"
+
+#define NAME(a, b) NAME_(a, b)
+#define NAME_(a, b) a ## _ ## b
+#define STR(a) STR_(a)
+#define STR_(a) #a
+
+#ifdef ISA
+
+namespace ISA {
+
+#include "simd.hh"
+#include "transpose.hh"
+#include "algorithms.hh"
+#include "layered_decoder.hh"
+
+#ifdef __AVX512BW__
+const int SIZEOF_SIMD = 64;
+#elif defined(__AVX2__)
+const int SIZEOF_SIMD = 32;
+#else
+const int SIZEOF_SIMD = 16;
+#endif
+
+typedef int8_t code_type;
+typedef SIMD<code_type, SIZEOF_SIMD> simd_type;
+typedef NormalUpdate<simd_type> update_type;
+typedef OffsetMinSumAlgorithm<simd_type, update_type, 2> algorithm_type;
+
+class Decoder : public DecoderInterface
+{
+	LDPCDecoder<simd_type, algorithm_type> decode;
+	simd_type *simd;
+	int N, K;
+	bool initialized;
+public:
+	Decoder() : initialized(false)
+	{
+	}
+	const char *name()
+	{
+		return STR(ISA);
+	}
+	int width()
+	{
+		return simd_type::SIZE;
+	}
+	void init(LDPCInterface *it)
+	{
+		if (initialized)
+			delete[] simd;
+		initialized = true;
+		N = it->code_len();
+		K = it->data_len();
+		decode.init(it);
+		simd = new simd_type[N];
+	}
+	int operator()(int8_t *code, int blocks, int trials)
+	{
+		pack(simd, code, N, blocks);
+		int count = decode(simd, simd + K, trials, blocks);
+		unpack(code, simd, N, blocks);
+		return count;
+	}
+	~Decoder()
+	{
+		if (initialized)
+			delete[] simd;
+	}
+};
+
+}
+
+DecoderInterface *NAME(create_decoder, ISA)()
+{
+	return new ISA::Decoder();
+}
+
+#else
+
+DecoderInterface *create_decoder_generic();
+#if defined(__x86_64__) || defined(__i386__)
+DecoderInterface *create_decoder_sse4_1();
+DecoderInterface *create_decoder_avx2();
+DecoderInterface *create_decoder_avx512();
+#endif
+
+DecoderInterface *create_decoder()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512bw"))
+		return create_decoder_avx512();
+	if (__builtin_cpu_supports("avx2"))
+		return create_decoder_avx2();
+	if (__builtin_cpu_supports("sse4.1"))
+		return create_decoder_sse4_1();
+#endif
+	return create_decoder_generic();
+}
+
+#endif
+
@@ -0,0 +1,153 @@
+/*
+Pool of LDPC decoders running in parallel threads
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#ifndef DECODER_POOL_HH
+#define DECODER_POOL_HH
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include "ldpc.hh"
+#include "transpose.hh"
+
+template <typename TYPE, typename ALG>
+class LDPCDecoder;
+
+template <typename TYPE, typename ALG>
+class LDPCDecoderPool
+{
+	typedef typename TYPE::value_type code_type;
+	static const int WIDTH = TYPE::SIZE;
+	struct Batch
+	{
+		code_type *code;
+		int *count;
+		int blocks, trials;
+	};
+	struct Worker
+	{
+		LDPCDecoder<TYPE, ALG> decode;
+		std::deque<Batch> queue;
+		std::mutex mutex;
+		std::thread thread;
+		TYPE *simd;
+	};
+	Worker *workers;
+	std::mutex mutex;
+	std::condition_variable work, done;
+	int num, next, queued, pending, N, K;
+	bool quit, initialized;
+
+	bool take(int id, Batch *batch)
+	{
+		for (int n = 0; n < num; ++n) {
+			Worker *w = workers + (id + n) % num;
+			std::lock_guard<std::mutex> lock(w->mutex);
+			if (w->queue.empty())
+				continue;
+			if (n) {
+				*batch = w->queue.back();
+				w->queue.pop_back();
+			} else {
+				*batch = w->queue.front();
+				w->queue.pop_front();
+			}
+			// uncount the batch while it leaves the queue, so idle workers don't wake up for it
+			std::lock_guard<std::mutex> count(mutex);
+			--queued;
+			return true;
+		}
+		return false;
+	}
+	void decode(Worker *w, Batch *batch)
+	{
+		pack(w->simd, batch->code, N, batch->blocks);
+		*batch->count = w->decode(w->simd, w->simd + K, batch->trials, batch->blocks);
+		unpack(batch->code, w->simd, N, batch->blocks);
+	}
+	void run(int id)
+	{
+		while (true) {
+			Batch batch;
+			if (take(id, &batch)) {
+				decode(workers + id, &batch);
+				std::lock_guard<std::mutex> lock(mutex);
+				if (!--pending)
+					done.notify_all();
+			} else {
+				std::unique_lock<std::mutex> lock(mutex);
+				work.wait(lock, [this]{ return quit || queued; });
+				if (quit && !queued)
+					return;
+			}
+		}
+	}
+public:
+	LDPCDecoderPool(int threads = std::thread::hardware_concurrency()) :
+		num(threads > 0 ? threads : 1), next(0), queued(0), pending(0), quit(false), initialized(false)
+	{
+		workers = new Worker[num];
+		for (int n = 0; n < num; ++n)
+			workers[n].thread = std::thread(&LDPCDecoderPool::run, this, n);
+	}
+	int threads()
+	{
+		return num;
+	}
+	void init(LDPCInterface *it)
+	{
+		wait();
+		if (initialized)
+			for (int n = 0; n < num; ++n)
+				delete[] workers[n].simd;
+		initialized = true;
+		N = it->code_len();
+		K = it->data_len();
+		for (int n = 0; n < num; ++n) {
+			workers[n].decode.init(it);
+			workers[n].simd = new TYPE[N];
+		}
+	}
+	// single producer: next is not guarded, so only one thread may push
+	void push(code_type *code, int *count, int blocks = WIDTH, int trials = 25)
+	{
+		Worker *w = workers + next;
+		next = (next + 1) % num;
+		// count first, so a worker taking the batch right away can never drive queued negative
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			++queued;
+			++pending;
+		}
+		{
+			std::lock_guard<std::mutex> lock(w->mutex);
+			w->queue.push_back(Batch { code, count, blocks, trials });
+		}
+		work.notify_one();
+	}
+	void wait()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [this]{ return !pending; });
+	}
+	~LDPCDecoderPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			quit = true;
+		}
+		work.notify_all();
+		for (int n = 0; n < num; ++n)
+			workers[n].thread.join();
+		if (initialized)
+			for (int n = 0; n < num; ++n)
+				delete[] workers[n].simd;
+		delete[] workers;
+	}
+};
+
+#endif
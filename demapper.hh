@@ -0,0 +1,97 @@
+/*
+Fused soft demapper, bit deinterleaver and lane transpose
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#ifndef DEMAPPER_HH
+#define DEMAPPER_HH
+
+#include <type_traits>
+#include "interleaver.hh"
+
+template <typename TYPE, typename CODE>
+struct DemapperInterface
+{
+	typedef TYPE complex_type;
+	typedef typename TYPE::value_type value_type;
+	typedef CODE code_type;
+
+	virtual int width() = 0;
+	virtual void init(Interleaver<code_type> *) = 0;
+	virtual void operator()(code_type *, complex_type *, int, value_type) = 0;
+	virtual ~DemapperInterface() = default;
+};
+
+template <typename MOD, int NUM, int WIDTH>
+class Demapper : public DemapperInterface<typename MOD::complex_type, typename MOD::code_type>
+{
+	typedef typename MOD::complex_type complex_type;
+	typedef typename MOD::value_type value_type;
+	typedef typename MOD::code_type code_type;
+	static const int BITS = MOD::BITS;
+	static const int N = NUM * BITS;
+	uint16_t pos[N];
+public:
+	int width()
+	{
+		return WIDTH;
+	}
+	// each received bit goes straight to where bwd would move it
+	void init(Interleaver<code_type> *itl)
+	{
+		uint16_t *src = new uint16_t[N];
+		trace_sources(src, itl, N);
+		for (int i = 0; i < N; ++i)
+			pos[src[i]] = i;
+		delete[] src;
+	}
+	// demap up to WIDTH frames of NUM symbols each into N lanes of WIDTH LLRs
+	void operator()(code_type *lane, complex_type *c, int frames, value_type precision)
+	{
+		if constexpr (std::is_same<code_type, int8_t>::value && WIDTH % 4 == 0) {
+			typedef SIMD<value_type, WIDTH / 4> vec;
+			typedef SIMD<code_type, WIDTH> out;
+			out *llr = reinterpret_cast<out *>(lane);
+			const int T = 16;
+			vec re[T][4], im[T][4];
+			for (int t = 0; t < T; ++t)
+				for (int i = 0; i < 4; ++i)
+					re[t][i] = im[t][i] = vzero<vec>();
+			const uint16_t *p = pos;
+			for (int s = 0; s < NUM; s += T) {
+				int len = s + T > NUM ? NUM - s : T;
+				for (int n = 0; n < frames; ++n) {
+					// frames are far apart and too many for the hardware prefetcher to follow
+					__builtin_prefetch(c + NUM * n + s + 4 * T);
+					__builtin_prefetch(c + NUM * n + s + 4 * T + T / 2);
+					for (int t = 0; t < len; ++t) {
+						complex_type x = c[NUM*n+s+t];
+						re[t][n/(WIDTH/4)].v[n%(WIDTH/4)] = x.real();
+						im[t][n/(WIDTH/4)].v[n%(WIDTH/4)] = x.imag();
+					}
+				}
+				for (int t = 0; t < len; ++t, p += BITS) {
+					out b[BITS];
+					MOD::template soft<WIDTH / 4>(b, re[t], im[t], precision);
+					for (int k = 0; k < BITS; ++k)
+						llr[p[k]] = b[k];
+				}
+			}
+		} else {
+			for (int i = 0; i < N * WIDTH; ++i)
+				lane[i] = 0;
+			const uint16_t *p = pos;
+			for (int s = 0; s < NUM; ++s, p += BITS) {
+				for (int n = 0; n < frames; ++n) {
+					code_type b[BITS];
+					MOD::soft(b, c[NUM*n+s], precision);
+					for (int k = 0; k < BITS; ++k)
+						lane[WIDTH*p[k]+n] = b[k];
+				}
+			}
+		}
+	}
+};
+
+#endif
@@ -7,12 +7,13 @@ Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
 #ifndef ENCODER_HH
 #define ENCODER_HH
 
-#include "ldpc.hh"
+#include "graph.hh"
 
 template <typename TYPE>
 class LDPCEncoder
 {
-	LDPCInterface *ldpc;
+	const LDPCGraph *graph;
+	const LDPCGraph *own;
 	int N, K, R;
 	bool initialized;
 
@@ -29,28 +30,33 @@ public:
 	{
 	}
 	void init(LDPCInterface *it)
+	{
+		const LDPCGraph *tmp = LDPCGraph::acquire(it);
+		init(tmp);
+		own = tmp;
+	}
+	void init(const LDPCGraph *it)
 	{
 		if (initialized)
-			delete ldpc;
+			LDPCGraph::release(own);
 		initialized = true;
-		ldpc = it->clone();
-		N = ldpc->code_len();
-		K = ldpc->data_len();
+		own = 0;
+		graph = it;
+		N = graph->code_len();
+		K = graph->data_len();
 		R = N - K;
 	}
 	void operator()(TYPE *data, TYPE *parity)
 	{
 		for (int i = 0; i < R; ++i)
 			parity[i] = one();
-		ldpc->first_bit();
 		for (int j = 0; j < K; ++j) {
-			int *acc_pos = ldpc->acc_pos();
-			int bit_deg = ldpc->bit_deg();
+			const uint16_t *acc_pos = graph->acc_pos(j);
+			int bit_deg = graph->bit_deg(j);
 			for (int n = 0; n < bit_deg; ++n) {
 				int i = acc_pos[n];
 				parity[i] = sign(parity[i], data[j]);
 			}
-			ldpc->next_bit();
 		}
 		for (int i = 1; i < R; ++i)
 			parity[i] = sign(parity[i], parity[i-1]);
@@ -58,7 +64,7 @@ public:
 	~LDPCEncoder()
 	{
 		if (initialized)
-			delete ldpc;
+			LDPCGraph::release(own);
 	}
 };
 
@@ -7,14 +7,14 @@ Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
 #ifndef ENCODER_HH
 #define ENCODER_HH
 
-#include "ldpc.hh"
+#include "graph.hh"
 
 template <typename TYPE>
 class LDPCEncoder
 {
-	uint16_t *pos;
-	uint8_t *cnc;
-	int R, CNL;
+	const LDPCGraph *graph;
+	const LDPCGraph *own;
+	int R;
 	bool initialized;
 
 	TYPE one()
@@ -31,47 +31,34 @@ public:
 	}
 	void init(LDPCInterface *it)
 	{
-		if (initialized) {
-			delete[] pos;
-			delete[] cnc;
-		}
+		const LDPCGraph *tmp = LDPCGraph::acquire(it);
+		init(tmp);
+		own = tmp;
+	}
+	void init(const LDPCGraph *it)
+	{
+		if (initialized)
+			LDPCGraph::release(own);
 		initialized = true;
-		LDPCInterface *ldpc = it->clone();
-		int N = ldpc->code_len();
-		int K = ldpc->data_len();
-		R = N - K;
-		CNL = ldpc->links_max_cn() - 2;
-		pos = new uint16_t[R * CNL];
-		cnc = new uint8_t[R];
-		for (int i = 0; i < R; ++i)
-			cnc[i] = 0;
-		ldpc->first_bit();
-		for (int j = 0; j < K; ++j) {
-			int *acc_pos = ldpc->acc_pos();
-			int bit_deg = ldpc->bit_deg();
-			for (int n = 0; n < bit_deg; ++n) {
-				int i = acc_pos[n];
-				pos[CNL*i+cnc[i]++] = j;
-			}
-			ldpc->next_bit();
-		}
-		delete ldpc;
+		own = 0;
+		graph = it;
+		R = graph->code_len() - graph->data_len();
 	}
 	void operator()(TYPE *data, TYPE *parity)
 	{
 		TYPE tmp = one();
 		for (int i = 0; i < R; ++i) {
-			for (int j = 0; j < cnc[i]; ++j)
-				tmp = sign(tmp, data[pos[CNL*i+j]]);
+			const uint16_t *pos = graph->check_pos(i);
+			int cnt = graph->check_deg(i);
+			for (int j = 0; j < cnt; ++j)
+				tmp = sign(tmp, data[pos[j]]);
 			parity[i] = tmp;
 		}
 	}
 	~LDPCEncoder()
 	{
-		if (initialized) {
-			delete[] pos;
-			delete[] cnc;
-		}
+		if (initialized)
+			LDPCGraph::release(own);
 	}
 };
 
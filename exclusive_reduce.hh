@@ -10,7 +10,7 @@ Copyright 2018 Ahmet Inan <inan@aicodix.de>
 namespace CODE {
 
 template <typename TYPE, typename OPERATOR>
-void exclusive_reduce(const TYPE *in, TYPE *out, int N, OPERATOR op)
+static inline void exclusive_reduce(const TYPE *in, TYPE *out, int N, OPERATOR op)
 {
 	TYPE pre = in[0];
 	for (int i = 1; i < N-1; ++i) {
@@ -8,14 +8,15 @@ Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
 #define FLOODING_DECODER_HH
 
 #include "exclusive_reduce.hh"
-#include "ldpc.hh"
+#include "graph.hh"
 
 template <typename TYPE, typename ALG>
 class LDPCDecoder
 {
 	TYPE *bnl, *bnv, *cnl, *cnv;
 	uint8_t *cnc;
-	LDPCInterface *ldpc;
+	const LDPCGraph *graph;
+	const LDPCGraph *own;
 	ALG alg;
 	int N, K, R, CNL, LT;
 	bool initialized;
@@ -30,13 +31,11 @@ class LDPCDecoder
 		}
 		bnv[R-1] = parity[R-1];
 		*bl++ = parity[R-1];
-		ldpc->first_bit();
 		for (int j = 0; j < K; ++j) {
 			bnv[j+R] = data[j];
-			int bit_deg = ldpc->bit_deg();
+			int bit_deg = graph->bit_deg(j);
 			for (int n = 0; n < bit_deg; ++n)
 				*bl++ = data[j];
-			ldpc->next_bit();
 		}
 	}
 	void check_node_update()
@@ -51,16 +50,14 @@ class LDPCDecoder
 			cnl[CNL*i+1] = *bl++;
 			cnc[i] = 2;
 		}
-		ldpc->first_bit();
 		for (int j = 0; j < K; ++j) {
-			int *acc_pos = ldpc->acc_pos();
-			int bit_deg = ldpc->bit_deg();
+			const uint16_t *acc_pos = graph->acc_pos(j);
+			int bit_deg = graph->bit_deg(j);
 			for (int n = 0; n < bit_deg; ++n) {
 				int i = acc_pos[n];
 				cnv[i] = alg.sign(cnv[i], bnv[j+R]);
 				cnl[CNL*i+cnc[i]++] = *bl++;
 			}
-			ldpc->next_bit();
 		}
 		for (int i = 0; i < R; ++i)
 			alg.finalp(cnl+CNL*i, cnc[i]);
@@ -81,10 +78,9 @@ class LDPCDecoder
 		bnv[R-1] = alg.add(parity[R-1], cnl[CNL*(R-1)+1]);
 		alg.update(bl++, parity[R-1]);
 		cnc[R-1] = 2;
-		ldpc->first_bit();
 		for (int j = 0; j < K; ++j) {
-			int *acc_pos = ldpc->acc_pos();
-			int bit_deg = ldpc->bit_deg();
+			const uint16_t *acc_pos = graph->acc_pos(j);
+			int bit_deg = graph->bit_deg(j);
 			TYPE inp[bit_deg];
 			for (int n = 0; n < bit_deg; ++n) {
 				int i = acc_pos[n];
@@ -95,15 +91,14 @@ class LDPCDecoder
 			bnv[j+R] = alg.add(data[j], alg.add(out[0], inp[0]));
 			for (int n = 0; n < bit_deg; ++n)
 				alg.update(bl++, alg.add(data[j], out[n]));
-			ldpc->next_bit();
 		}
 	}
 	bool hard_decision(int blocks)
 	{
+		TYPE acc = alg.one();
 		for (int i = 0; i < R; ++i)
-			if (alg.bad(cnv[i], blocks))
-				return true;
-		return false;
+			acc = alg.sign(alg.sign(acc, alg.add(cnv[i], alg.one())), cnv[i]);
+		return alg.bad(acc, blocks);
 	}
 	void update_user(TYPE *data, TYPE *parity)
 	{
@@ -117,6 +112,12 @@ public:
 	{
 	}
 	void init(LDPCInterface *it)
+	{
+		const LDPCGraph *tmp = LDPCGraph::acquire(it);
+		init(tmp);
+		own = tmp;
+	}
+	void init(const LDPCGraph *it)
 	{
 		if (initialized) {
 			delete[] bnl;
@@ -124,21 +125,28 @@ public:
 			delete[] cnl;
 			delete[] cnv;
 			delete[] cnc;
-			delete ldpc;
+			LDPCGraph::release(own);
 		}
 		initialized = true;
-		ldpc = it->clone();
-		N = ldpc->code_len();
-		K = ldpc->data_len();
+		own = 0;
+		graph = it;
+		N = graph->code_len();
+		K = graph->data_len();
 		R = N - K;
-		CNL = ldpc->links_max_cn();
-		LT = ldpc->links_total();
+		CNL = graph->links_max_cn();
+		LT = graph->links_total();
 		bnl = new TYPE[LT];
 		bnv = new TYPE[N];
 		cnl = new TYPE[R * CNL];
 		cnv = new TYPE[R];
 		cnc = new uint8_t[R];
 	}
+	void init(const LDPCDecoder *dec)
+	{
+		const LDPCGraph *tmp = LDPCGraph::acquire(dec->graph);
+		init(tmp);
+		own = tmp;
+	}
 	int operator()(TYPE *data, TYPE *parity, int trials = 50, int blocks = 1)
 	{
 		bit_node_init(data, parity);
@@ -163,7 +171,7 @@ public:
 			delete[] cnl;
 			delete[] cnv;
 			delete[] cnc;
-			delete ldpc;
+			LDPCGraph::release(own);
 		}
 	}
 };
@@ -0,0 +1,141 @@
+/*
+LDPC graph in compressed sparse row and column form
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#ifndef GRAPH_HH
+#define GRAPH_HH
+
+#include <mutex>
+#include "ldpc.hh"
+
+class LDPCGraph
+{
+	const uint16_t *chk_pos;
+	const uint8_t *chk_deg;
+	uint16_t *bit_pos;
+	int *bit_off;
+	const void *key;
+	LDPCGraph *next;
+	int N, K, M, R, q, CNL, LT, refs;
+
+	static LDPCGraph *&cache()
+	{
+		static LDPCGraph *head;
+		return head;
+	}
+	static std::mutex &mutex()
+	{
+		static std::mutex m;
+		return m;
+	}
+public:
+	LDPCGraph(LDPCInterface *it) : key(0), next(0), refs(0)
+	{
+		LDPCInterface *ldpc = it->clone();
+		N = ldpc->code_len();
+		K = ldpc->data_len();
+		M = ldpc->group_len();
+		R = N - K;
+		q = R / M;
+		CNL = ldpc->links_max_cn() - 2;
+		LT = ldpc->links_total();
+		chk_pos = ldpc->layered_pos();
+		chk_deg = ldpc->check_degs();
+		bit_off = new int[K + 1];
+		bit_pos = new uint16_t[LT - 2 * R + 1];
+		bit_off[0] = 0;
+		ldpc->first_bit();
+		for (int j = 0; j < K; ++j) {
+			int *acc_pos = ldpc->acc_pos();
+			int bit_deg = ldpc->bit_deg();
+			for (int n = 0; n < bit_deg; ++n)
+				bit_pos[bit_off[j]+n] = acc_pos[n];
+			bit_off[j+1] = bit_off[j] + bit_deg;
+			ldpc->next_bit();
+		}
+		delete ldpc;
+	}
+	// one graph per table for the whole process, shared until the last user releases it
+	static const LDPCGraph *acquire(LDPCInterface *it)
+	{
+		std::lock_guard<std::mutex> lock(mutex());
+		for (LDPCGraph *graph = cache(); graph; graph = graph->next) {
+			if (graph->key == it->table()) {
+				++graph->refs;
+				return graph;
+			}
+		}
+		LDPCGraph *graph = new LDPCGraph(it);
+		graph->key = it->table();
+		graph->refs = 1;
+		graph->next = cache();
+		cache() = graph;
+		return graph;
+	}
+	// another reference to a graph already acquired
+	static const LDPCGraph *acquire(const LDPCGraph *graph)
+	{
+		std::lock_guard<std::mutex> lock(mutex());
+		++const_cast<LDPCGraph *>(graph)->refs;
+		return graph;
+	}
+	static void release(const LDPCGraph *graph)
+	{
+		std::lock_guard<std::mutex> lock(mutex());
+		for (LDPCGraph **link = &cache(); *link; link = &(*link)->next) {
+			if (*link == graph) {
+				LDPCGraph *tmp = *link;
+				if (!--tmp->refs) {
+					*link = tmp->next;
+					delete tmp;
+				}
+				return;
+			}
+		}
+	}
+	int code_len() const
+	{
+		return N;
+	}
+	int data_len() const
+	{
+		return K;
+	}
+	int group_len() const
+	{
+		return M;
+	}
+	int links_total() const
+	{
+		return LT;
+	}
+	int links_max_cn() const
+	{
+		return CNL + 2;
+	}
+	int bit_deg(int j) const
+	{
+		return bit_off[j+1] - bit_off[j];
+	}
+	const uint16_t *acc_pos(int j) const
+	{
+		return bit_pos + bit_off[j];
+	}
+	int check_deg(int i) const
+	{
+		return chk_deg[i % q];
+	}
+	const uint16_t *check_pos(int i) const
+	{
+		return chk_pos + CNL * (M * (i % q) + i / q);
+	}
+	~LDPCGraph()
+	{
+		delete[] bit_off;
+		delete[] bit_pos;
+	}
+};
+
+#endif
@@ -7,19 +7,47 @@ Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
 #ifndef INTERLEAVER_HH
 #define INTERLEAVER_HH
 
+#include <cstdint>
+#include <cstring>
+#include "packed_bits.hh"
+
+// no state is kept between calls, so one object can be shared by many threads
 template <typename TYPE>
 struct Interleaver
 {
-	virtual void fwd(TYPE *) = 0;
-	virtual void bwd(TYPE *) = 0;
+	// in place, tmp needs room for a whole frame
+	virtual void fwd(TYPE *io, TYPE *tmp) = 0;
+	virtual void bwd(TYPE *io, TYPE *tmp) = 0;
+	// out of place, leaving in untouched
+	virtual void fwd(TYPE *out, const TYPE *in, TYPE *tmp) = 0;
+	virtual void bwd(TYPE *out, const TYPE *in, TYPE *tmp) = 0;
+	// transmitter side on bits packed MSB first, tmp needs room for 3 * packed_words(N)
+	virtual void fwd(uint8_t *out, const uint8_t *in, uint64_t *tmp) = 0;
 	virtual ~Interleaver() = default;
 };
 
 template <typename TYPE>
-struct ITL0 : public Interleaver<TYPE>
+class ITL0 : public Interleaver<TYPE>
 {
-	void fwd(TYPE *){}
-	void bwd(TYPE *){}
+	int N;
+public:
+	ITL0(int len) : N(len)
+	{
+	}
+	void fwd(TYPE *, TYPE *){}
+	void bwd(TYPE *, TYPE *){}
+	void fwd(TYPE *out, const TYPE *in, TYPE *)
+	{
+		std::memcpy(out, in, sizeof(TYPE) * N);
+	}
+	void bwd(TYPE *out, const TYPE *in, TYPE *)
+	{
+		std::memcpy(out, in, sizeof(TYPE) * N);
+	}
+	void fwd(uint8_t *out, const uint8_t *in, uint64_t *)
+	{
+		std::memcpy(out, in, N / 8);
+	}
 };
 
 template <typename TYPE, typename PITL, typename MUX>
@@ -28,31 +56,158 @@ struct BITL : public Interleaver<TYPE>
 	static const int N = PITL::N;
 	static const int COLS = MUX::N;
 	static const int ROWS = N / COLS;
-	TYPE tmp[N];
-	void fwd(TYPE *io)
+	void fwd(TYPE *io, TYPE *tmp)
 	{
 		PITL::fwd(tmp, io);
 		for (int row = 0; row < ROWS; ++row)
 			MUX::fwd(io+COLS*row, tmp+row, ROWS);
 	}
-	void bwd(TYPE *io)
+	void bwd(TYPE *io, TYPE *tmp)
 	{
 		for (int row = 0; row < ROWS; ++row)
 			MUX::bwd(tmp+row, io+COLS*row, ROWS);
 		PITL::bwd(io, tmp);
 	}
+	// out is free until the MUX pass, so PITL may use it as scratch
+	void fwd(TYPE *out, const TYPE *in, TYPE *tmp)
+	{
+		PITL::fwd(tmp, in, out);
+		for (int row = 0; row < ROWS; ++row)
+			MUX::fwd(out+COLS*row, tmp+row, ROWS);
+	}
+	void bwd(TYPE *out, const TYPE *in, TYPE *tmp)
+	{
+		for (int row = 0; row < ROWS; ++row)
+			MUX::bwd(tmp+row, in+COLS*row, ROWS);
+		PITL::bwd(out, tmp);
+	}
+	// the column wise writes and row wise reads become bit matrix transposes
+	void fwd(uint8_t *out, const uint8_t *in, uint64_t *tmp)
+	{
+		const int W = packed_words(N);
+		uint64_t *a = tmp, *b = tmp + W, *c = tmp + 2 * W;
+		bytes_to_words(a, in, N);
+		PITL::fwd(b, a, c);
+		zip_bits<COLS>(a, b, ROWS, MUX::E, 0);
+		words_to_bytes(out, a, N);
+	}
+};
+
+// find where bwd moves each received bit by sending the bits of its index through it,
+// so bwd puts the bit from src[i] to i, TYPE may also be a SIMD vector
+template <typename TYPE>
+static void trace_sources(uint16_t *src, Interleaver<TYPE> *itl, int N)
+{
+	TYPE *bits = new TYPE[N];
+	TYPE *tmp = new TYPE[N];
+	for (int i = 0; i < N; ++i)
+		src[i] = 0;
+	for (int l = 0; (1 << l) < N; ++l) {
+		for (int i = 0; i < N; ++i)
+			bits[i] = (i >> l) & 1;
+		itl->bwd(bits, tmp);
+		for (int i = 0; i < N; ++i)
+			src[i] |= (bits[i] != 0) << l;
+	}
+	delete[] bits;
+	delete[] tmp;
+}
+
+// whole chain of another interleaver collapsed into a single gather pass per direction
+template <typename TYPE>
+class PermutationInterleaver : public Interleaver<TYPE>
+{
+	uint16_t *src, *dst;
+	int N;
+	bool initialized;
+
+	// locals, as stores through TYPE=int8_t may alias the members,
+	// grouping the table by source block or following the cycles in place only moved the misses around
+	void gather(TYPE *out, const TYPE *in, const uint16_t *p)
+	{
+		int n = N;
+		for (int i = 0; i < n; ++i)
+			out[i] = in[p[i]];
+	}
+public:
+	PermutationInterleaver() : initialized(false)
+	{
+	}
+	// TYPE may also be a SIMD vector of ELEM, permuting the frames in all of its lanes at once
+	template <typename ELEM>
+	void init(Interleaver<ELEM> *itl, int len)
+	{
+		if (initialized) {
+			delete[] src;
+			delete[] dst;
+		}
+		initialized = true;
+		N = len;
+		src = new uint16_t[N];
+		dst = new uint16_t[N];
+		trace_sources(src, itl, N);
+		// scattering is much slower than gathering, so keep the inverse too
+		for (int i = 0; i < N; ++i)
+			dst[src[i]] = i;
+	}
+	void fwd(TYPE *io, TYPE *tmp)
+	{
+		std::memcpy(tmp, io, sizeof(TYPE) * N);
+		gather(io, tmp, dst);
+	}
+	void bwd(TYPE *io, TYPE *tmp)
+	{
+		std::memcpy(tmp, io, sizeof(TYPE) * N);
+		gather(io, tmp, src);
+	}
+	// needs no scratch out of place
+	void fwd(TYPE *out, const TYPE *in, TYPE *)
+	{
+		gather(out, in, dst);
+	}
+	void bwd(TYPE *out, const TYPE *in, TYPE *)
+	{
+		gather(out, in, src);
+	}
+	void fwd(uint8_t *out, const uint8_t *in, uint64_t *)
+	{
+		for (int i = 0; i < N / 8; ++i) {
+			int val = 0;
+			for (int k = 0; k < 8; ++k) {
+				int j = dst[8*i+k];
+				val = (val << 1) | ((in[j/8] >> (7 - j % 8)) & 1);
+			}
+			out[i] = val;
+		}
+	}
+	~PermutationInterleaver()
+	{
+		if (initialized) {
+			delete[] src;
+			delete[] dst;
+		}
+	}
 };
 
 template <typename TYPE, int NUM>
 struct PITL0
 {
 	static const int N = NUM;
-	static void fwd(TYPE *out, TYPE *in)
+	static void fwd(TYPE *out, const TYPE *in)
 	{
 		for (int n = 0; n < N; ++n)
 			out[n] = in[n];
 	}
-	static void bwd(TYPE *out, TYPE *in)
+	static void fwd(TYPE *out, const TYPE *in, TYPE *)
+	{
+		fwd(out, in);
+	}
+	static void fwd(uint64_t *out, const uint64_t *in, uint64_t *)
+	{
+		for (int i = 0; i < packed_words(N); ++i)
+			out[i] = in[i];
+	}
+	static void bwd(TYPE *out, const TYPE *in)
 	{
 		for (int n = 0; n < N; ++n)
 			out[n] = in[n];
@@ -65,7 +220,7 @@ struct PITL
 	static const int N = NUM;
 	static const int M = 360;
 	static const int K = N - M * Q;
-	static void fwd(TYPE *out, TYPE *in)
+	static void fwd(TYPE *out, const TYPE *in)
 	{
 		for (int k = 0; k < K; ++k)
 			out[k] = in[k];
@@ -73,7 +228,21 @@ struct PITL
 			for (int m = 0; m < M; ++m)
 				out[K+M*q+m] = in[K+Q*m+q];
 	}
-	static void bwd(TYPE *out, TYPE *in)
+	static void fwd(TYPE *out, const TYPE *in, TYPE *)
+	{
+		fwd(out, in);
+	}
+	static void fwd(uint64_t *out, const uint64_t *in, uint64_t *)
+	{
+		for (int i = 0; i < K / 64; ++i)
+			out[i] = in[i];
+		for (int i = K / 64; i < packed_words(N); ++i)
+			out[i] = 0;
+		if (K % 64)
+			out[K/64] = in[K/64] & packed_mask(K % 64);
+		transpose_bits(out, in, K, M, Q);
+	}
+	static void bwd(TYPE *out, const TYPE *in)
 	{
 		for (int k = 0; k < K; ++k)
 			out[k] = in[k];
@@ -97,6 +266,18 @@ struct PCTITL
 		for (int row = 0; row < ROWS; ++row)
 			CT::fwd(out+COLS*row, in, ROWS, row);
 	}
+	// same without the copy by using tmp instead of in as scratch
+	static void fwd(TYPE *out, const TYPE *in, TYPE *tmp)
+	{
+		PITL<TYPE, N, Q>::fwd(tmp, in);
+		for (int row = 0; row < ROWS; ++row)
+			CT::fwd(out+COLS*row, tmp, ROWS, row);
+	}
+	static void fwd(uint64_t *out, const uint64_t *in, uint64_t *tmp)
+	{
+		PITL<TYPE, N, Q>::fwd(tmp, in, 0);
+		zip_bits<COLS>(out, tmp, ROWS, 0, CT::T);
+	}
 	static void bwd(TYPE *out, TYPE *in)
 	{
 		for (int row = 0; row < ROWS; ++row)
@@ -111,11 +292,12 @@ template <typename TYPE>
 struct MUX0
 {
 	static const int N = 1;
-	static void fwd(TYPE *out, TYPE *in, int)
+	static constexpr int E[N] = { 0 };
+	static void fwd(TYPE *out, const TYPE *in, int)
 	{
 		out[0] = in[0];
 	}
-	static void bwd(TYPE *out, TYPE *in, int)
+	static void bwd(TYPE *out, const TYPE *in, int)
 	{
 		out[0] = in[0];
 	}
@@ -125,13 +307,14 @@ template <typename TYPE, int E0, int E1, int E2>
 struct MUX3
 {
 	static const int N = 3;
-	static void fwd(TYPE *out, TYPE *in, int S)
+	static constexpr int E[N] = { E0, E1, E2 };
+	static void fwd(TYPE *out, const TYPE *in, int S)
 	{
 		out[E0] = in[0*S];
 		out[E1] = in[1*S];
 		out[E2] = in[2*S];
 	}
-	static void bwd(TYPE *out, TYPE *in, int S)
+	static void bwd(TYPE *out, const TYPE *in, int S)
 	{
 		out[0*S] = in[E0];
 		out[1*S] = in[E1];
@@ -143,7 +326,8 @@ template <typename TYPE, int E0, int E1, int E2, int E3, int E4, int E5, int E6,
 struct MUX8
 {
 	static const int N = 8;
-	static void fwd(TYPE *out, TYPE *in, int S)
+	static constexpr int E[N] = { E0, E1, E2, E3, E4, E5, E6, E7 };
+	static void fwd(TYPE *out, const TYPE *in, int S)
 	{
 		out[E0] = in[0*S];
 		out[E1] = in[1*S];
@@ -154,7 +338,7 @@ struct MUX8
 		out[E6] = in[6*S];
 		out[E7] = in[7*S];
 	}
-	static void bwd(TYPE *out, TYPE *in, int S)
+	static void bwd(TYPE *out, const TYPE *in, int S)
 	{
 		out[0*S] = in[E0];
 		out[1*S] = in[E1];
@@ -171,7 +355,8 @@ template <typename TYPE, int E0, int E1, int E2, int E3, int E4, int E5, int E6,
 struct MUX12
 {
 	static const int N = 12;
-	static void fwd(TYPE *out, TYPE *in, int S)
+	static constexpr int E[N] = { E0, E1, E2, E3, E4, E5, E6, E7, E8, E9, E10, E11 };
+	static void fwd(TYPE *out, const TYPE *in, int S)
 	{
 		out[E0] = in[0*S];
 		out[E1] = in[1*S];
@@ -186,7 +371,7 @@ struct MUX12
 		out[E10] = in[10*S];
 		out[E11] = in[11*S];
 	}
-	static void bwd(TYPE *out, TYPE *in, int S)
+	static void bwd(TYPE *out, const TYPE *in, int S)
 	{
 		out[0*S] = in[E0];
 		out[1*S] = in[E1];
@@ -207,7 +392,8 @@ template <typename TYPE, int E0, int E1, int E2, int E3, int E4, int E5, int E6,
 struct MUX16
 {
 	static const int N = 16;
-	static void fwd(TYPE *out, TYPE *in, int S)
+	static constexpr int E[N] = { E0, E1, E2, E3, E4, E5, E6, E7, E8, E9, E10, E11, E12, E13, E14, E15 };
+	static void fwd(TYPE *out, const TYPE *in, int S)
 	{
 		out[E0] = in[0*S];
 		out[E1] = in[1*S];
@@ -226,7 +412,7 @@ struct MUX16
 		out[E14] = in[14*S];
 		out[E15] = in[15*S];
 	}
-	static void bwd(TYPE *out, TYPE *in, int S)
+	static void bwd(TYPE *out, const TYPE *in, int S)
 	{
 		out[0*S] = in[E0];
 		out[1*S] = in[E1];
@@ -251,7 +437,8 @@ template <typename TYPE, int T0, int T1, int T2, int T3, int T4, int T5, int T6,
 struct CT8
 {
 	static const int N = 8;
-	static void fwd(TYPE *out, TYPE *in, int S, int R)
+	static constexpr int T[N] = { T0, T1, T2, T3, T4, T5, T6, T7 };
+	static void fwd(TYPE *out, const TYPE *in, int S, int R)
 	{
 		out[0] = in[0*S+(R+S-T0)%S];
 		out[1] = in[1*S+(R+S-T1)%S];
@@ -262,7 +449,7 @@ struct CT8
 		out[6] = in[6*S+(R+S-T6)%S];
 		out[7] = in[7*S+(R+S-T7)%S];
 	}
-	static void bwd(TYPE *out, TYPE *in, int S, int R)
+	static void bwd(TYPE *out, const TYPE *in, int S, int R)
 	{
 		out[0*S+(R+S-T0)%S] = in[0];
 		out[1*S+(R+S-T1)%S] = in[1];
@@ -279,7 +466,8 @@ template <typename TYPE, int T0, int T1, int T2, int T3, int T4, int T5, int T6,
 struct CT12
 {
 	static const int N = 12;
-	static void fwd(TYPE *out, TYPE *in, int S, int R)
+	static constexpr int T[N] = { T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11 };
+	static void fwd(TYPE *out, const TYPE *in, int S, int R)
 	{
 		out[0] = in[0*S+(R+S-T0)%S];
 		out[1] = in[1*S+(R+S-T1)%S];
@@ -294,7 +482,7 @@ struct CT12
 		out[10] = in[10*S+(R+S-T10)%S];
 		out[11] = in[11*S+(R+S-T11)%S];
 	}
-	static void bwd(TYPE *out, TYPE *in, int S, int R)
+	static void bwd(TYPE *out, const TYPE *in, int S, int R)
 	{
 		out[0*S+(R+S-T0)%S] = in[0];
 		out[1*S+(R+S-T1)%S] = in[1];
@@ -315,7 +503,8 @@ template <typename TYPE, int T0, int T1, int T2, int T3, int T4, int T5, int T6,
 struct CT16
 {
 	static const int N = 16;
-	static void fwd(TYPE *out, TYPE *in, int S, int R)
+	static constexpr int T[N] = { T0, T1, T2, T3, T4, T5, T6, T7, T8, T9, T10, T11, T12, T13, T14, T15 };
+	static void fwd(TYPE *out, const TYPE *in, int S, int R)
 	{
 		out[0] = in[0*S+(R+S-T0)%S];
 		out[1] = in[1*S+(R+S-T1)%S];
@@ -334,7 +523,7 @@ struct CT16
 		out[14] = in[14*S+(R+S-T14)%S];
 		out[15] = in[15*S+(R+S-T15)%S];
 	}
-	static void bwd(TYPE *out, TYPE *in, int S, int R)
+	static void bwd(TYPE *out, const TYPE *in, int S, int R)
 	{
 		out[0*S+(R+S-T0)%S] = in[0];
 		out[1*S+(R+S-T1)%S] = in[1];
@@ -9,7 +9,7 @@ Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
 #include "testbench.hh"
 #include "interleaver.hh"
 
-Interleaver<code_type> *create_interleaver(char *modulation, char *standard, char prefix, int number)
+Interleaver<code_type> *create_interleaver(char *modulation, char *standard, char prefix, int number, int len)
 {
 	if (!strcmp(standard, "S2")) {
 		if (!strcmp(modulation, "8PSK")) {
@@ -213,6 +213,6 @@ Interleaver<code_type> *create_interleaver(char *modulation, char *standard, cha
 		}
 	}
 	std::cerr << "using noop interleaver." << std::endl;
-	return new ITL0<code_type>();
+	return new ITL0<code_type>(len);
 }
 
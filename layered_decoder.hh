@@ -13,10 +13,10 @@ template <typename TYPE, typename ALG>
 class LDPCDecoder
 {
 	TYPE *bnl, *pty;
-	uint16_t *pos;
-	uint8_t *cnc;
+	const uint16_t *pos;
+	const uint8_t *cnc;
 	ALG alg;
-	int M, N, K, R, q, CNL, LT;
+	int M, N, K, R, q, CNL, LT, BNL, PTY;
 	bool initialized;
 
 	void reset()
@@ -24,10 +24,12 @@ class LDPCDecoder
 		for (int i = 0; i < LT; ++i)
 			bnl[i] = alg.zero();
 	}
+	// a lane of acc stays positive only while all checks of the row group are satisfied
 	bool bad(TYPE *data, TYPE *parity, int blocks)
 	{
 		for (int i = 0; i < q; ++i) {
 			int cnt = cnc[i];
+			TYPE acc = alg.one();
 			for (int j = 0; j < M; ++j) {
 				TYPE cnv = alg.sign(alg.one(), parity[M*i+j]);
 				if (i)
@@ -36,19 +38,67 @@ class LDPCDecoder
 					cnv = alg.sign(cnv, parity[j+(q-1)*M-1]);
 				for (int c = 0; c < cnt; ++c)
 					cnv = alg.sign(cnv, data[pos[CNL*(M*i+j)+c]]);
-				if (alg.bad(cnv, blocks))
-					return true;
+				acc = alg.sign(alg.sign(acc, alg.add(cnv, alg.one())), cnv);
 			}
+			if (alg.bad(acc, blocks))
+				return true;
 		}
 		return false;
 	}
-	void update(TYPE *data, TYPE *parity)
+	void bad(bool *lanes, TYPE *data, TYPE *parity)
 	{
-		TYPE *bl = bnl;
+		TYPE acc = alg.one();
+		for (int i = 0; i < q; ++i) {
+			int cnt = cnc[i];
+			for (int j = 0; j < M; ++j) {
+				TYPE cnv = alg.sign(alg.one(), parity[M*i+j]);
+				if (i)
+					cnv = alg.sign(cnv, parity[M*(i-1)+j]);
+				else if (j)
+					cnv = alg.sign(cnv, parity[j+(q-1)*M-1]);
+				for (int c = 0; c < cnt; ++c)
+					cnv = alg.sign(cnv, data[pos[CNL*(M*i+j)+c]]);
+				acc = alg.sign(alg.sign(acc, alg.add(cnv, alg.one())), cnv);
+			}
+			bool all = true;
+			for (int n = 0; n < TYPE::SIZE; ++n)
+				all = all && (lanes[n] || acc.v[n] <= 0);
+			if (all)
+				break;
+		}
+		for (int n = 0; n < TYPE::SIZE; ++n)
+			lanes[n] = lanes[n] || acc.v[n] <= 0;
+	}
+	template <typename CODE>
+	void load(int lane, TYPE *data, CODE *frame)
+	{
+		for (int i = 0; i < K; ++i)
+			data[i].v[lane] = frame[i];
+		for (int i = 0; i < q; ++i)
+			for (int j = 0; j < M; ++j)
+				pty[M*i+j].v[lane] = frame[K+q*j+i];
+	}
+	template <typename CODE>
+	void store(CODE *frame, int lane, TYPE *data)
+	{
+		for (int i = 0; i < K; ++i)
+			frame[i] = data[i].v[lane];
+		for (int i = 0; i < q; ++i)
+			for (int j = 0; j < M; ++j)
+				frame[K+q*j+i] = pty[M*i+j].v[lane];
+	}
+	// with FUSED, a lane of the result stays positive only if all checks were satisfied right after their update
+	template <bool FUSED = false>
+	TYPE update(TYPE *data, TYPE *parity, TYPE *keep = 0)
+	{
+		TYPE *bl = bnl, acc = alg.one();
 		for (int i = 0; i < q; ++i) {
 			int cnt = cnc[i];
 			for (int j = 0; j < M; ++j) {
 				int deg = cnt + 2 - !(i|j);
+				if (keep)
+					for (int d = 0; d < deg; ++d)
+						bl[d] = alg.sign(bl[d], *keep);
 				TYPE inp[deg], out[deg];
 				for (int c = 0; c < cnt; ++c)
 					inp[c] = out[c] = alg.sub(data[pos[CNL*(M*i+j)+c]], bl[c]);
@@ -60,16 +110,42 @@ class LDPCDecoder
 				alg.finalp(out, deg);
 				for (int d = 0; d < deg; ++d)
 					alg.update(bl+d, out[d]);
+				for (int d = 0; d < deg; ++d)
+					inp[d] = alg.add(inp[d], bl[d]);
 				for (int c = 0; c < cnt; ++c)
-					data[pos[CNL*(M*i+j)+c]] = alg.add(inp[c], bl[c]);
-				parity[M*i+j] = alg.add(inp[cnt], bl[cnt]);
+					data[pos[CNL*(M*i+j)+c]] = inp[c];
+				parity[M*i+j] = inp[cnt];
 				if (i)
-					parity[M*(i-1)+j] = alg.add(inp[cnt+1], bl[cnt+1]);
+					parity[M*(i-1)+j] = inp[cnt+1];
 				else if (j)
-					parity[j+(q-1)*M-1] = alg.add(inp[cnt+1], bl[cnt+1]);
+					parity[j+(q-1)*M-1] = inp[cnt+1];
+				if (FUSED) {
+					TYPE cnv = alg.one();
+					for (int d = 0; d < deg; ++d)
+						cnv = alg.sign(cnv, inp[d]);
+					acc = alg.sign(alg.sign(acc, alg.add(cnv, alg.one())), cnv);
+				}
 				bl += deg;
 			}
 		}
+		return acc;
+	}
+	// buffers only grow, so switching back and forth between codes does not allocate
+	void grow()
+	{
+		if (!initialized || BNL < LT) {
+			if (initialized)
+				delete[] bnl;
+			BNL = LT;
+			bnl = new TYPE[BNL];
+		}
+		if (!initialized || PTY < R) {
+			if (initialized)
+				delete[] pty;
+			PTY = R;
+			pty = new TYPE[PTY];
+		}
+		initialized = true;
 	}
 public:
 	LDPCDecoder() : initialized(false)
@@ -77,45 +153,29 @@ public:
 	}
 	void init(LDPCInterface *it)
 	{
-		if (initialized) {
-			delete[] bnl;
-			delete[] pty;
-			delete[] cnc;
-			delete[] pos;
-		}
-		initialized = true;
-		LDPCInterface *ldpc = it->clone();
-		N = ldpc->code_len();
-		K = ldpc->data_len();
-		M = ldpc->group_len();
+		N = it->code_len();
+		K = it->data_len();
+		M = it->group_len();
 		R = N - K;
 		q = R / M;
-		CNL = ldpc->links_max_cn() - 2;
-		pos = new uint16_t[R * CNL];
-		cnc = new uint8_t[R];
-		for (int i = 0; i < R; ++i)
-			cnc[i] = 0;
-		ldpc->first_bit();
-		for (int j = 0; j < K; ++j) {
-			int *acc_pos = ldpc->acc_pos();
-			int bit_deg = ldpc->bit_deg();
-			for (int n = 0; n < bit_deg; ++n) {
-				int i = acc_pos[n];
-				pos[CNL*i+cnc[i]++] = j;
-			}
-			ldpc->next_bit();
-		}
-		LT = ldpc->links_total();
-		delete ldpc;
-		bnl = new TYPE[LT];
-		pty = new TYPE[R];
-		uint16_t *tmp = new uint16_t[R * CNL];
-		for (int i = 0; i < q; ++i)
-			for (int j = 0; j < M; ++j)
-				for (int c = 0; c < CNL; ++c)
-					tmp[CNL*(M*i+j)+c] = pos[CNL*(q*j+i)+c];
-		delete[] pos;
-		pos = tmp;
+		CNL = it->links_max_cn() - 2;
+		LT = it->links_total();
+		pos = it->layered_pos();
+		cnc = it->check_degs();
+		grow();
+	}
+	void init(const LDPCDecoder *dec)
+	{
+		N = dec->N;
+		K = dec->K;
+		M = dec->M;
+		R = dec->R;
+		q = dec->q;
+		CNL = dec->CNL;
+		LT = dec->LT;
+		pos = dec->pos;
+		cnc = dec->cnc;
+		grow();
 	}
 	int operator()(TYPE *data, TYPE *parity, int trials = 25, int blocks = 1)
 	{
@@ -130,13 +190,109 @@ public:
 				parity[q*j+i] = pty[M*i+j];
 		return trials;
 	}
+	// same as above, but the syndrome comes with the update and the full pass only confirms convergence,
+	// opt-in as the estimate costs more per update than the separate pass it saves on the codes measured so far
+	int fused(TYPE *data, TYPE *parity, int trials = 25, int blocks = 1)
+	{
+		reset();
+		for (int i = 0; i < q; ++i)
+			for (int j = 0; j < M; ++j)
+				pty[M*i+j] = parity[q*j+i];
+		bool fail = bad(data, pty, blocks);
+		while (fail && --trials >= 0)
+			fail = alg.bad(update<true>(data, pty), blocks) || bad(data, pty, blocks);
+		for (int i = 0; i < q; ++i)
+			for (int j = 0; j < M; ++j)
+				parity[q*j+i] = pty[M*i+j];
+		return trials;
+	}
+	// same as operator() above, but with the trials left for every lane in counts, returns the lowest of them
+	int operator()(int *counts, TYPE *data, TYPE *parity, int trials = 25, int blocks = 1)
+	{
+		bool lanes[TYPE::SIZE];
+		reset();
+		for (int i = 0; i < q; ++i)
+			for (int j = 0; j < M; ++j)
+				pty[M*i+j] = parity[q*j+i];
+		for (int n = 0; n < blocks; ++n)
+			counts[n] = trials;
+		while (true) {
+			for (int n = 0; n < TYPE::SIZE; ++n)
+				lanes[n] = n >= blocks || counts[n] < 0;
+			bad(lanes, data, pty);
+			bool more = false;
+			for (int n = 0; n < blocks; ++n)
+				if (lanes[n] && counts[n] >= 0)
+					more = --counts[n] >= 0 || more;
+			if (!more)
+				break;
+			update(data, pty);
+		}
+		for (int i = 0; i < q; ++i)
+			for (int j = 0; j < M; ++j)
+				parity[q*j+i] = pty[M*i+j];
+		int lowest = trials;
+		for (int n = 0; n < blocks; ++n)
+			if (counts[n] < lowest)
+				lowest = counts[n];
+		return lowest;
+	}
+	template <typename FETCH, typename RETIRE>
+	int stream(FETCH fetch, RETIRE retire, int trials = 25)
+	{
+		const int WIDTH = TYPE::SIZE;
+		typename TYPE::value_type *frames[WIDTH];
+		int counts[WIDTH];
+		bool lanes[WIDTH];
+		TYPE *data = new TYPE[K];
+		reset();
+		int active = 0, retired = 0;
+		for (int n = 0; n < WIDTH; ++n) {
+			frames[n] = fetch();
+			if (frames[n]) {
+				load(n, data, frames[n]);
+				counts[n] = trials;
+				++active;
+			}
+		}
+		while (active) {
+			for (int n = 0; n < WIDTH; ++n)
+				lanes[n] = !frames[n];
+			bad(lanes, data, pty);
+			TYPE keep = alg.one();
+			bool refill = false;
+			for (int n = 0; n < WIDTH; ++n) {
+				if (!frames[n] || (lanes[n] && counts[n] > 0))
+					continue;
+				if (lanes[n])
+					counts[n] = -1;
+				store(frames[n], n, data);
+				retire(frames[n], counts[n]);
+				++retired;
+				frames[n] = fetch();
+				if (frames[n]) {
+					load(n, data, frames[n]);
+					keep.v[n] = 0;
+					refill = true;
+					counts[n] = trials;
+				} else {
+					--active;
+				}
+			}
+			for (int n = 0; n < WIDTH; ++n)
+				if (frames[n])
+					--counts[n];
+			if (active)
+				update(data, pty, refill ? &keep : 0);
+		}
+		delete[] data;
+		return retired;
+	}
 	~LDPCDecoder()
 	{
 		if (initialized) {
 			delete[] bnl;
 			delete[] pty;
-			delete[] cnc;
-			delete[] pos;
 		}
 	}
 };
@@ -7,9 +7,14 @@ Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
 #ifndef LDPC_HH
 #define LDPC_HH
 
+#include <cstdint>
+
 struct LDPCInterface
 {
 	virtual LDPCInterface *clone() = 0;
+	virtual const void *table() = 0;
+	virtual const uint16_t *layered_pos() = 0;
+	virtual const uint8_t *check_degs() = 0;
 	virtual int code_len() = 0;
 	virtual int data_len() = 0;
 	virtual int group_len() = 0;
@@ -22,6 +27,47 @@ struct LDPCInterface
 	virtual ~LDPCInterface() = default;
 };
 
+// data bit positions of the checks in the order the layered decoders visit them: check q*j+i is row M*i+j
+template <typename TABLE>
+struct LDPCLayered
+{
+	static const int M = TABLE::M;
+	static const int R = TABLE::N - TABLE::K;
+	static const int q = R / M;
+	static const int CNL = TABLE::LINKS_MAX_CN - 2;
+	static const int E = (TABLE::LINKS_TOTAL - 2 * R + 1) / M;
+	uint16_t pos[R * CNL];
+	uint8_t cnc[q];
+
+	// table entries are sorted into buckets per row group first, so pos gets filled in order
+	constexpr LDPCLayered() : pos(), cnc()
+	{
+		int off[q+1] = {}, base[E] = {}, shift[E] = {}, fill[q] = {};
+		for (int e = 0; e < E; ++e)
+			++off[TABLE::POS[e]%q+1];
+		for (int i = 0; i < q; ++i)
+			off[i+1] += off[i];
+		const int *row = TABLE::POS;
+		int j = 0;
+		for (int g = 0; TABLE::LEN[g]; ++g) {
+			for (int l = 0; l < TABLE::LEN[g]; ++l, j += M) {
+				for (int n = 0; n < TABLE::DEG[g]; ++n, ++row) {
+					int i = *row % q, e = off[i] + fill[i]++;
+					base[e] = j;
+					shift[e] = *row / q;
+				}
+			}
+		}
+		uint16_t *p = pos;
+		for (int i = 0; i < q; ++i) {
+			cnc[i] = off[i+1] - off[i];
+			for (int k = 0; k < M; ++k, p += CNL)
+				for (int e = off[i], c = 0; e < off[i+1]; ++e, ++c)
+					p[c] = base[e] + (k - shift[e] + M) % M;
+		}
+	}
+};
+
 template <typename TABLE>
 class LDPC : public LDPCInterface
 {
@@ -52,11 +98,29 @@ class LDPC : public LDPCInterface
 		row_ptr += bit_deg_;
 		++grp_cnt;
 	}
+	// built once per process on first use, so only the codes in use cost time and memory
+	static const LDPCLayered<TABLE> *layered()
+	{
+		static const LDPCLayered<TABLE> *tmp = new LDPCLayered<TABLE>();
+		return tmp;
+	}
 public:
 	LDPCInterface *clone()
 	{
 		return new LDPC<TABLE>();
 	}
+	const void *table()
+	{
+		return TABLE::POS;
+	}
+	const uint16_t *layered_pos()
+	{
+		return layered()->pos;
+	}
+	const uint8_t *check_degs()
+	{
+		return layered()->cnc;
+	}
 	int code_len()
 	{
 		return N;
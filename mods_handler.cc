@@ -10,38 +10,57 @@ Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
 #include "psk.hh"
 #include "qam.hh"
 #include "modulation.hh"
+#include "demapper.hh"
 #include "testbench.hh"
 
+ModulationInterface<complex_type, code_type> *create_modulation(char *name, int len)
+{
+	if (!strcmp(name, "BPSK"))
+		return new Modulation<PhaseShiftKeying<2, complex_type, code_type>, SIMD_WIDTH>(len);
+	if (!strcmp(name, "QPSK"))
+		return new Modulation<PhaseShiftKeying<4, complex_type, code_type>, SIMD_WIDTH>(len);
+	if (!strcmp(name, "8PSK"))
+		return new Modulation<PhaseShiftKeying<8, complex_type, code_type>, SIMD_WIDTH>(len);
+	if (!strcmp(name, "QAM16"))
+		return new Modulation<QuadratureAmplitudeModulation<16, complex_type, code_type>, SIMD_WIDTH>(len);
+	if (!strcmp(name, "QAM64"))
+		return new Modulation<QuadratureAmplitudeModulation<64, complex_type, code_type>, SIMD_WIDTH>(len);
+	if (!strcmp(name, "QAM256"))
+		return new Modulation<QuadratureAmplitudeModulation<256, complex_type, code_type>, SIMD_WIDTH>(len);
+	if (!strcmp(name, "QAM1024"))
+		return new Modulation<QuadratureAmplitudeModulation<1024, complex_type, code_type>, SIMD_WIDTH>(len);
+	return 0;
+}
+
 template <int LEN>
-ModulationInterface<complex_type, code_type> *create_modulation(char *name)
+DemapperInterface<complex_type, code_type> *create_demapper(char *name)
 {
 	if (!strcmp(name, "BPSK"))
-		return new Modulation<PhaseShiftKeying<2, complex_type, code_type>, LEN>();
+		return new Demapper<PhaseShiftKeying<2, complex_type, code_type>, LEN, SIMD_WIDTH>();
 	if (!strcmp(name, "QPSK"))
-		return new Modulation<PhaseShiftKeying<4, complex_type, code_type>, LEN / 2>();
+		return new Demapper<PhaseShiftKeying<4, complex_type, code_type>, LEN / 2, SIMD_WIDTH>();
 	if (!strcmp(name, "8PSK"))
-		return new Modulation<PhaseShiftKeying<8, complex_type, code_type>, LEN / 3>();
+		return new Demapper<PhaseShiftKeying<8, complex_type, code_type>, LEN / 3, SIMD_WIDTH>();
 	if (!strcmp(name, "QAM16"))
-		return new Modulation<QuadratureAmplitudeModulation<16, complex_type, code_type>, LEN / 4>();
+		return new Demapper<QuadratureAmplitudeModulation<16, complex_type, code_type>, LEN / 4, SIMD_WIDTH>();
 	if (!strcmp(name, "QAM64"))
-		return new Modulation<QuadratureAmplitudeModulation<64, complex_type, code_type>, LEN / 6>();
+		return new Demapper<QuadratureAmplitudeModulation<64, complex_type, code_type>, LEN / 6, SIMD_WIDTH>();
 	if (!strcmp(name, "QAM256"))
-		return new Modulation<QuadratureAmplitudeModulation<256, complex_type, code_type>, LEN / 8>();
+		return new Demapper<QuadratureAmplitudeModulation<256, complex_type, code_type>, LEN / 8, SIMD_WIDTH>();
 	if (!strcmp(name, "QAM1024"))
-		return new Modulation<QuadratureAmplitudeModulation<1024, complex_type, code_type>, LEN / 10>();
+		return new Demapper<QuadratureAmplitudeModulation<1024, complex_type, code_type>, LEN / 10, SIMD_WIDTH>();
 	return 0;
 }
 
-ModulationInterface<complex_type, code_type> *create_modulation(char *name, int len)
+DemapperInterface<complex_type, code_type> *create_demapper(char *name, int len)
 {
 	switch (len) {
 	case 16200:
-		return create_modulation<16200>(name);
+		return create_demapper<16200>(name);
 	case 32400:
-		return create_modulation<32400>(name);
+		return create_demapper<32400>(name);
 	case 64800:
-		return create_modulation<64800>(name);
+		return create_demapper<64800>(name);
 	}
 	return 0;
 }
-
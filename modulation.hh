@@ -7,6 +7,11 @@ Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
 #ifndef MODULATION_HH
 #define MODULATION_HH
 
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include "simd.hh"
+
 template <typename TYPE, typename CODE>
 struct ModulationInterface
 {
@@ -18,19 +23,44 @@ struct ModulationInterface
 	virtual void hardN(code_type *, complex_type *) = 0;
 	virtual void softN(code_type *, complex_type *, value_type) = 0;
 	virtual void mapN(complex_type *, code_type *) = 0;
+	virtual void mapN(complex_type *, const uint8_t *) = 0;
+	// same for any number of symbols, packed bits need to start on a byte
+	virtual void hardN(code_type *, complex_type *, int) = 0;
+	virtual void softN(code_type *, complex_type *, value_type, int) = 0;
+	virtual void mapN(complex_type *, code_type *, int) = 0;
+	virtual void mapN(complex_type *, const uint8_t *, int) = 0;
 	virtual void hard(code_type *, complex_type) = 0;
 	virtual void soft(code_type *, complex_type, value_type) = 0;
 	virtual complex_type map(code_type *) = 0;
 	virtual ~ModulationInterface() = default;
 };
 
-template <typename MOD, int NUM>
+// WIDTH is the number of code_type lanes the SIMD soft demapping may use
+template <typename MOD, int WIDTH>
 struct Modulation : public ModulationInterface<typename MOD::complex_type, typename MOD::code_type>
 {
 	typedef typename MOD::complex_type complex_type;
 	typedef typename MOD::value_type value_type;
 	typedef typename MOD::code_type code_type;
 
+	// symbols of a whole byte at once, if they fit
+	static const int GROUP = 8 % MOD::BITS ? MOD::BITS : 8;
+	static const int SYMS = GROUP / MOD::BITS;
+	complex_type lut[(1 << GROUP) * SYMS];
+	int NUM;
+
+	// constellation points for every group of bits, first bit in the MSB
+	Modulation(int len) : NUM(len / MOD::BITS)
+	{
+		for (int i = 0; i < (1 << GROUP); ++i) {
+			code_type b[GROUP];
+			for (int k = 0; k < GROUP; ++k)
+				b[k] = 1 - 2 * ((i >> (GROUP - 1 - k)) & 1);
+			for (int k = 0; k < SYMS; ++k)
+				lut[SYMS*i+k] = MOD::map(b + k * MOD::BITS);
+		}
+	}
+
 	int bits()
 	{
 		return MOD::BITS;
@@ -38,22 +68,113 @@ struct Modulation : public ModulationInterface<typename MOD::complex_type, typen
 
 	void hardN(code_type *b, complex_type *c)
 	{
-		for (int i = 0; i < NUM; ++i)
-			MOD::hard(b + i * MOD::BITS, c[i]);
+		hardN(b, c, NUM);
 	}
 
 	void softN(code_type *b, complex_type *c, value_type precision)
 	{
-		for (int i = 0; i < NUM; ++i)
-			MOD::soft(b + i * MOD::BITS, c[i], precision);
+		softN(b, c, precision, NUM);
 	}
 
 	void mapN(complex_type *c, code_type *b)
 	{
-		for (int i = 0; i < NUM; ++i)
+		mapN(c, b, NUM);
+	}
+
+	void mapN(complex_type *c, const uint8_t *b)
+	{
+		mapN(c, b, NUM);
+	}
+
+	void hardN(code_type *b, complex_type *c, int num)
+	{
+		for (int i = 0; i < num; ++i)
+			MOD::hard(b + i * MOD::BITS, c[i]);
+	}
+
+	void softN(code_type *b, complex_type *c, value_type precision, int num)
+	{
+		int i = 0;
+		if constexpr (std::is_same<code_type, int8_t>::value && WIDTH % 4 == 0) {
+			const int BITS = MOD::BITS, LANES = WIDTH / 4;
+			// zipping needs a power of two, so the bits of a symbol get padded to PAD
+			const int PAD = BITS <= 1 ? 1 : BITS <= 2 ? 2 : BITS <= 4 ? 4 : BITS <= 8 ? 8 : 16;
+			typedef SIMD<value_type, LANES> vec;
+			typedef SIMD<code_type, WIDTH> out;
+			for (; i + WIDTH <= num; i += WIDTH) {
+				vec re[4], im[4];
+				const value_type *val = reinterpret_cast<const value_type *>(c + i);
+				for (int k = 0; k < 4; ++k) {
+					for (int n = 0; n < LANES; ++n) {
+						re[k].v[n] = val[2*(LANES*k+n)];
+						im[k].v[n] = val[2*(LANES*k+n)+1];
+					}
+				}
+				out tmp[PAD], zip[PAD];
+				MOD::template soft<LANES>(tmp, re, im, precision);
+				for (int k = BITS; k < PAD; ++k)
+					tmp[k] = vzero<out>();
+				// same stages as vtranspose(), leaving the PAD bits of every symbol next to each other
+				for (int s = 1; s < PAD; s *= 2) {
+					for (int k = 0; k < PAD / 2; ++k) {
+						zip[2*k] = vzip1(tmp[k], tmp[PAD/2+k]);
+						zip[2*k+1] = vzip2(tmp[k], tmp[PAD/2+k]);
+					}
+					for (int k = 0; k < PAD; ++k)
+						tmp[k] = zip[k];
+				}
+				if (BITS == PAD) {
+					std::memcpy(b + BITS * i, tmp, sizeof(tmp));
+				} else {
+					const code_type *bits = reinterpret_cast<const code_type *>(tmp);
+					for (int n = 0; n < WIDTH; ++n)
+						std::memcpy(b + BITS * (i + n), bits + PAD * n, BITS);
+				}
+			}
+		}
+		for (; i < num; ++i)
+			MOD::soft(b + i * MOD::BITS, c[i], precision);
+	}
+
+	void mapN(complex_type *c, code_type *b, int num)
+	{
+		for (int i = 0; i < num; ++i)
 			c[i] = MOD::map(b + i * MOD::BITS);
 	}
 
+	// bits packed MSB first
+	void mapN(complex_type *c, const uint8_t *b, int num)
+	{
+		const int BITS = MOD::BITS;
+		if constexpr (GROUP == 8) {
+			int i = 0;
+			for (; i < num / SYMS; ++i)
+				std::memcpy(c + SYMS * i, lut + SYMS * b[i], sizeof(complex_type) * SYMS);
+			if (num % SYMS)
+				std::memcpy(c + SYMS * i, lut + SYMS * b[i], sizeof(complex_type) * (num % SYMS));
+		} else {
+			// 8 symbols fill a whole number of bytes, or 4 for more than 8 bits
+			const int NUMS = BITS <= 8 ? 8 : 4, BYTES = NUMS * BITS / 8;
+			int i = 0;
+			for (; i + NUMS <= num; i += NUMS, b += BYTES) {
+				uint64_t acc = 0;
+				for (int k = 0; k < BYTES; ++k)
+					acc = (acc << 8) | b[k];
+				for (int k = 0; k < NUMS; ++k)
+					c[i+k] = lut[(acc >> (BITS * (NUMS - 1 - k))) & ((1 << BITS) - 1)];
+			}
+			uint32_t acc = 0;
+			for (int cnt = 0; i < num; ++i) {
+				while (cnt < BITS) {
+					acc = (acc << 8) | *b++;
+					cnt += 8;
+				}
+				cnt -= BITS;
+				c[i] = lut[(acc >> cnt) & ((1 << BITS) - 1)];
+			}
+		}
+	}
+
 	void hard(code_type *b, complex_type c)
 	{
 		MOD::hard(b, c);
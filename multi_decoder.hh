@@ -0,0 +1,80 @@
+/*
+LDPC decoder switching between several codes from call to call
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#ifndef MULTI_DECODER_HH
+#define MULTI_DECODER_HH
+
+#include "ldpc.hh"
+
+template <typename TYPE, typename ALG>
+class LDPCDecoder;
+
+template <typename TYPE, typename ALG>
+class LDPCMultiDecoder
+{
+	LDPCDecoder<TYPE, ALG> decode;
+	LDPCInterface **ldpcs;
+	int num, cur;
+	bool initialized;
+public:
+	LDPCMultiDecoder() : initialized(false)
+	{
+	}
+	void init(LDPCInterface **codes, int count)
+	{
+		if (initialized) {
+			for (int n = 0; n < num; ++n)
+				delete ldpcs[n];
+			delete[] ldpcs;
+		}
+		initialized = true;
+		num = count;
+		ldpcs = new LDPCInterface *[num];
+		for (int n = 0; n < num; ++n)
+			ldpcs[n] = codes[n]->clone();
+		for (int n = 0; n < num; ++n)
+			decode.init(ldpcs[n]);
+		cur = num - 1;
+	}
+	int codes()
+	{
+		return num;
+	}
+	int code_len(int code)
+	{
+		return ldpcs[code]->code_len();
+	}
+	int data_len(int code)
+	{
+		return ldpcs[code]->data_len();
+	}
+	int operator()(int code, TYPE *data, TYPE *parity, int trials = 25, int blocks = 1)
+	{
+		if (code != cur) {
+			decode.init(ldpcs[code]);
+			cur = code;
+		}
+		return decode(data, parity, trials, blocks);
+	}
+	int operator()(int code, int *counts, TYPE *data, TYPE *parity, int trials = 25, int blocks = 1)
+	{
+		if (code != cur) {
+			decode.init(ldpcs[code]);
+			cur = code;
+		}
+		return decode(counts, data, parity, trials, blocks);
+	}
+	~LDPCMultiDecoder()
+	{
+		if (initialized) {
+			for (int n = 0; n < num; ++n)
+				delete ldpcs[n];
+			delete[] ldpcs;
+		}
+	}
+};
+
+#endif
@@ -459,6 +459,14 @@ inline SIMD<int8_t, 16> vmul(SIMD<int8_t, 16> a, SIMD<int8_t, 16> b)
 	return tmp;
 }
 
+template <>
+inline SIMD<float, 4> vneg(SIMD<float, 4> a)
+{
+	SIMD<float, 4> tmp;
+	tmp.m = vnegq_f32(a.m);
+	return tmp;
+}
+
 template <>
 inline SIMD<float, 4> vabs(SIMD<float, 4> a)
 {
@@ -979,3 +987,68 @@ inline SIMD<int8_t, 16> vshuf(SIMD<int8_t, 16> a, SIMD<uint8_t, 16> b)
 	return tmp;
 }
 
+#ifdef __aarch64__
+template <>
+inline SIMD<int32_t, 4> vcvtn(SIMD<float, 4> a)
+{
+	SIMD<int32_t, 4> tmp;
+	tmp.m = vcvtnq_s32_f32(a.m);
+	return tmp;
+}
+#endif
+
+template <>
+inline SIMD<float, 4> vcvt(SIMD<int32_t, 4> a)
+{
+	SIMD<float, 4> tmp;
+	tmp.m = vcvtq_f32_s32(a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 8> vqmovn(SIMD<int32_t, 4> a, SIMD<int32_t, 4> b)
+{
+	SIMD<int16_t, 8> tmp;
+	tmp.m = vcombine_s16(vqmovn_s32(a.m), vqmovn_s32(b.m));
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 16> vqmovn(SIMD<int16_t, 8> a, SIMD<int16_t, 8> b)
+{
+	SIMD<int8_t, 16> tmp;
+	tmp.m = vcombine_s8(vqmovn_s16(a.m), vqmovn_s16(b.m));
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 16> vzip1(SIMD<int8_t, 16> a, SIMD<int8_t, 16> b)
+{
+	SIMD<int8_t, 16> tmp;
+	tmp.m = vzipq_s8(a.m, b.m).val[0];
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 16> vzip2(SIMD<int8_t, 16> a, SIMD<int8_t, 16> b)
+{
+	SIMD<int8_t, 16> tmp;
+	tmp.m = vzipq_s8(a.m, b.m).val[1];
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 8> vzip1(SIMD<int16_t, 8> a, SIMD<int16_t, 8> b)
+{
+	SIMD<int16_t, 8> tmp;
+	tmp.m = vzipq_s16(a.m, b.m).val[0];
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 8> vzip2(SIMD<int16_t, 8> a, SIMD<int16_t, 8> b)
+{
+	SIMD<int16_t, 8> tmp;
+	tmp.m = vzipq_s16(a.m, b.m).val[1];
+	return tmp;
+}
@@ -0,0 +1,181 @@
+/*
+Bit matrix operations on packed bits
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#ifndef PACKED_BITS_HH
+#define PACKED_BITS_HH
+
+#include <cstdint>
+
+// bits are packed MSB first into 64 bit words, with one extra word at the end for the unaligned accesses
+static constexpr int packed_words(int bits)
+{
+	return bits / 64 + 2;
+}
+
+static inline uint64_t packed_mask(int n)
+{
+	return ~uint64_t(0) << (64 - n);
+}
+
+// 64 bits starting at bit pos
+static inline uint64_t get_bits(const uint64_t *a, int pos)
+{
+	int w = pos / 64, s = pos % 64;
+	return s ? (a[w] << s) | (a[w+1] >> (64 - s)) : a[w];
+}
+
+// or in the bits of val starting at bit pos, unused bits of val need to be zero
+static inline void put_bits(uint64_t *a, int pos, uint64_t val)
+{
+	int w = pos / 64, s = pos % 64;
+	a[w] |= val >> s;
+	if (s)
+		a[w+1] |= val << (64 - s);
+}
+
+// written out so the compiler can turn these into byte swapping loads and stores
+static inline uint64_t load_be64(const uint8_t *b)
+{
+	return uint64_t(b[0]) << 56 | uint64_t(b[1]) << 48 | uint64_t(b[2]) << 40 | uint64_t(b[3]) << 32 |
+		uint64_t(b[4]) << 24 | uint64_t(b[5]) << 16 | uint64_t(b[6]) << 8 | uint64_t(b[7]);
+}
+
+static inline void store_be64(uint8_t *b, uint64_t v)
+{
+	b[0] = v >> 56; b[1] = v >> 48; b[2] = v >> 40; b[3] = v >> 32;
+	b[4] = v >> 24; b[5] = v >> 16; b[6] = v >> 8; b[7] = v;
+}
+
+static inline void bytes_to_words(uint64_t *words, const uint8_t *bytes, int bits)
+{
+	int n = bits / 8, i = 0;
+	for (; i + 8 <= n; i += 8)
+		words[i/8] = load_be64(bytes + i);
+	for (int w = i / 8; w < packed_words(bits); ++w)
+		words[w] = 0;
+	for (; i < n; ++i)
+		words[i/8] |= uint64_t(bytes[i]) << (56 - 8 * (i % 8));
+}
+
+static inline void words_to_bytes(uint8_t *bytes, const uint64_t *words, int bits)
+{
+	int n = bits / 8, i = 0;
+	for (; i + 8 <= n; i += 8)
+		store_be64(bytes + i, words[i/8]);
+	for (; i < n; ++i)
+		bytes[i] = words[i/8] >> (56 - 8 * (i % 8));
+}
+
+template <int J>
+static inline void transpose_swap(uint64_t *a, uint64_t m)
+{
+	for (int l = 0; l < 64; l += 2 * J) {
+		for (int k = l; k < l + J; ++k) {
+			uint64_t t = (a[k] ^ (a[k+J] >> J)) & m;
+			a[k] ^= t;
+			a[k+J] ^= t << J;
+		}
+	}
+}
+
+static inline void transpose64(uint64_t *a)
+{
+	transpose_swap<32>(a, 0x00000000FFFFFFFF);
+	transpose_swap<16>(a, 0x0000FFFF0000FFFF);
+	transpose_swap<8>(a, 0x00FF00FF00FF00FF);
+	transpose_swap<4>(a, 0x0F0F0F0F0F0F0F0F);
+	transpose_swap<2>(a, 0x3333333333333333);
+	transpose_swap<1>(a, 0x5555555555555555);
+}
+
+// rows by cols matrix starting at bit pos of in goes to cols by rows matrix at bit pos of out
+static void transpose_bits(uint64_t *out, const uint64_t *in, int pos, int rows, int cols)
+{
+	uint64_t blk[64];
+	for (int rb = 0; rb < rows; rb += 64) {
+		int nr = rows - rb < 64 ? rows - rb : 64;
+		for (int cb = 0; cb < cols; cb += 64) {
+			int nc = cols - cb < 64 ? cols - cb : 64;
+			uint64_t m = packed_mask(nc);
+			for (int r = 0; r < nr; ++r)
+				blk[r] = get_bits(in, pos + (rb + r) * cols + cb) & m;
+			for (int r = nr; r < 64; ++r)
+				blk[r] = 0;
+			transpose64(blk);
+			for (int c = 0; c < nc; ++c)
+				put_bits(out, pos + (cb + c) * rows + rb, blk[c]);
+		}
+	}
+}
+
+// interleave ROWS rows of len bits each: bit j of row r, rotated by twist[r], goes to bit ROWS*j+order[r] of out, which gets overwritten
+template <int ROWS>
+class BitZip
+{
+	static const int B = ROWS <= 8 ? 8 : 4;
+	uint64_t lut[1 << B];
+public:
+	// spread the B bits of the index apart by ROWS
+	constexpr BitZip() : lut()
+	{
+		for (int x = 0; x < (1 << B); ++x)
+			for (int k = 0; k < B; ++k)
+				if ((x >> (B - 1 - k)) & 1)
+					lut[x] |= uint64_t(1) << (63 - ROWS * k);
+	}
+	// read 64 bits of every row at once, spread them B bits at a time and collect whole words for out
+	void operator()(uint64_t *out, const uint64_t *in, int len, const int *order, const int *twist) const
+	{
+		uint64_t buf = 0;
+		int used = 0;
+		int sh[ROWS];
+		for (int r = 0; r < ROWS; ++r)
+			sh[r] = order ? order[r] : r;
+		for (int j = 0; j < len; j += 64) {
+			int n = len - j < 64 ? len - j : 64;
+			uint64_t v[ROWS];
+			for (int r = 0; r < ROWS; ++r) {
+				const int row = len * r;
+				int p = twist ? j - twist[r] : j;
+				if (p < 0)
+					p += len;
+				v[r] = get_bits(in, row + p);
+				if (p + n > len)
+					v[r] = (v[r] & packed_mask(len - p)) | (get_bits(in, row) >> (len - p));
+				v[r] &= packed_mask(n);
+			}
+			for (int k = 0; k < n; k += B) {
+				uint64_t acc = 0;
+				for (int r = 0; r < ROWS; ++r)
+					acc |= lut[(v[r] >> (64 - B - k)) & ((1 << B) - 1)] >> sh[r];
+				int bits = ROWS * (n - k < B ? n - k : B);
+				buf |= acc >> used;
+				used += bits;
+				if (used >= 64) {
+					*out++ = buf;
+					used -= 64;
+					buf = used ? acc << (bits - used) : 0;
+				}
+			}
+		}
+		if (used)
+			*out = buf;
+	}
+};
+
+template <int ROWS>
+struct BitZipTable
+{
+	static constexpr BitZip<ROWS> ZIP = BitZip<ROWS>();
+};
+
+template <int ROWS>
+static inline void zip_bits(uint64_t *out, const uint64_t *in, int len, const int *order, const int *twist)
+{
+	BitZipTable<ROWS>::ZIP(out, in, len, order, twist);
+}
+
+#endif
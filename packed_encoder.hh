@@ -0,0 +1,183 @@
+/*
+LDPC encoder for packed bits
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#ifndef PACKED_ENCODER_HH
+#define PACKED_ENCODER_HH
+
+#include "graph.hh"
+#include "packed_bits.hh"
+
+class LDPCPackedEncoder
+{
+	uint64_t *rows, *cols;
+	uint16_t *row, *rot;
+	uint8_t *cnt;
+	int M, K, R, q, G, W, B;
+	bool initialized;
+
+	void prefix()
+	{
+		for (int i = 1; i < q; ++i)
+			for (int w = 0; w < W; ++w)
+				rows[W*i+w] ^= rows[W*(i-1)+w];
+		uint64_t *last = rows + W * (q - 1), carry = 0, prev = 0;
+		for (int w = 0; w < W; ++w) {
+			uint64_t x = last[w];
+			for (int s = 1; s < 64; s <<= 1)
+				x ^= x >> s;
+			x ^= carry;
+			carry = -(x & 1);
+			uint64_t exc = (x >> 1) | (prev << 63);
+			prev = x;
+			for (int i = 0; i < q; ++i)
+				rows[W*i+w] ^= exc;
+		}
+	}
+	void columns()
+	{
+		uint64_t blk[64];
+		for (int b = 0; b < B; ++b) {
+			for (int w = 0; w < W; ++w) {
+				for (int r = 0; r < 64; ++r)
+					blk[r] = 64 * b + r < q ? rows[W*(64*b+r)+w] : 0;
+				transpose64(blk);
+				for (int c = 0; c < 64 && 64 * w + c < M; ++c)
+					cols[B*(64*w+c)+b] = blk[c];
+			}
+		}
+	}
+	static uint64_t get(const uint8_t *buf)
+	{
+		uint64_t val = 0;
+		for (int k = 0; k < 8; ++k)
+			val = (val << 8) | buf[k];
+		return val;
+	}
+	static void put(uint8_t *buf, uint64_t val)
+	{
+		for (int k = 0; k < 8; ++k)
+			buf[k] = val >> (56 - 8 * k);
+	}
+public:
+	LDPCPackedEncoder() : initialized(false)
+	{
+	}
+	void init(LDPCInterface *it)
+	{
+		const LDPCGraph *graph = LDPCGraph::acquire(it);
+		init(graph);
+		LDPCGraph::release(graph);
+	}
+	void init(const LDPCGraph *graph)
+	{
+		if (initialized) {
+			delete[] rows;
+			delete[] cols;
+			delete[] row;
+			delete[] rot;
+			delete[] cnt;
+		}
+		initialized = true;
+		M = graph->group_len();
+		K = graph->data_len();
+		R = graph->code_len() - K;
+		q = R / M;
+		G = K / M;
+		W = (M + 63) / 64;
+		B = (q + 63) / 64;
+		rows = new uint64_t[W * q];
+		cols = new uint64_t[B * M];
+		int num = 0;
+		for (int g = 0; g < G; ++g)
+			num += graph->bit_deg(M * g);
+		row = new uint16_t[num];
+		rot = new uint16_t[num];
+		cnt = new uint8_t[G];
+		for (int g = 0, n = 0; g < G; ++g) {
+			const uint16_t *acc_pos = graph->acc_pos(M * g);
+			cnt[g] = graph->bit_deg(M * g);
+			for (int d = 0; d < cnt[g]; ++d, ++n) {
+				row[n] = acc_pos[d] % q;
+				rot[n] = M - acc_pos[d] / q;
+			}
+		}
+	}
+	// bits are packed MSB first, K / 8 bytes of data in and R / 8 bytes of parity out
+	void operator()(const uint8_t *data, uint8_t *parity)
+	{
+		for (int i = 0; i < W * q; ++i)
+			rows[i] = 0;
+		int a = M / 64, b = M % 64;
+		const uint16_t *rw = row, *rt = rot;
+		for (int g = 0; g < G; ++g, data += M / 8) {
+			uint64_t grp[2*W+1];
+			for (int w = 0; w < M / 64; ++w)
+				grp[w] = get(data + 8 * w);
+			if (b) {
+				uint64_t tmp = 0;
+				for (int n = 0; n < b / 8; ++n)
+					tmp |= uint64_t(data[8*a+n]) << (56 - 8 * n);
+				grp[a] = tmp;
+			}
+			for (int w = a + 1; w < 2 * W + 1; ++w)
+				grp[w] = 0;
+			for (int w = W - 1; w >= 0; --w) {
+				if (b) {
+					grp[a+w] |= grp[w] >> b;
+					grp[a+w+1] |= grp[w] << (64 - b);
+				} else {
+					grp[a+w] = grp[w];
+				}
+			}
+			for (int d = 0; d < cnt[g]; ++d) {
+				uint64_t *acc = rows + W * *rw++;
+				int x = *rt / 64, y = *rt++ % 64;
+				if (y) {
+					for (int w = 0; w < W; ++w)
+						acc[w] ^= (grp[x+w] << y) | (grp[x+w+1] >> (64 - y));
+				} else {
+					for (int w = 0; w < W; ++w)
+						acc[w] ^= grp[x+w];
+				}
+			}
+		}
+		prefix();
+		columns();
+		const uint64_t *col = cols;
+		int n = q % 64 ? q % 64 : 64;
+		uint64_t acc = 0;
+		int used = 0;
+		for (int j = 0; j < M; ++j) {
+			for (int k = 0; k < B; ++k) {
+				uint64_t v = *col++;
+				int len = k < B - 1 ? 64 : n;
+				acc |= v >> used;
+				if (used + len < 64) {
+					used += len;
+				} else {
+					put(parity, acc);
+					parity += 8;
+					acc = used ? v << (64 - used) : 0;
+					used += len - 64;
+				}
+			}
+		}
+		for (int k = 0; k < used / 8; ++k)
+			*parity++ = acc >> (56 - 8 * k);
+	}
+	~LDPCPackedEncoder()
+	{
+		if (initialized) {
+			delete[] rows;
+			delete[] cols;
+			delete[] row;
+			delete[] rot;
+			delete[] cnt;
+		}
+	}
+};
+
+#endif
@@ -7,6 +7,8 @@ Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
 #ifndef PSK_HH
 #define PSK_HH
 
+#include "quantize.hh"
+
 template <int NUM, typename TYPE, typename CODE>
 struct PhaseShiftKeying;
 
@@ -23,12 +25,7 @@ struct PhaseShiftKeying<2, TYPE, CODE>
 
 	static code_type quantize(value_type precision, value_type value)
 	{
-		value *= DIST * precision;
-		if (std::is_integral<code_type>::value)
-			value = std::nearbyint(value);
-		if (std::is_same<code_type, int8_t>::value)
-			value = std::min<value_type>(std::max<value_type>(value, -128), 127);
-		return value;
+		return ::quantize<code_type>(DIST * precision, value);
 	}
 
 	static void hard(code_type *b, complex_type c)
@@ -41,6 +38,12 @@ struct PhaseShiftKeying<2, TYPE, CODE>
 		b[0] = quantize(precision, c.real());
 	}
 
+	template <int WIDTH>
+	static void soft(SIMD<code_type, 4 * WIDTH> *b, const SIMD<value_type, WIDTH> *re, const SIMD<value_type, WIDTH> *, value_type precision)
+	{
+		b[0] = ::quantize<code_type>(DIST * precision, re);
+	}
+
 	static complex_type map(code_type *b)
 	{
 		return complex_type(b[0], 0);
@@ -62,12 +65,7 @@ struct PhaseShiftKeying<4, TYPE, CODE>
 
 	static code_type quantize(value_type precision, value_type value)
 	{
-		value *= DIST * precision;
-		if (std::is_integral<code_type>::value)
-			value = std::nearbyint(value);
-		if (std::is_same<code_type, int8_t>::value)
-			value = std::min<value_type>(std::max<value_type>(value, -128), 127);
-		return value;
+		return ::quantize<code_type>(DIST * precision, value);
 	}
 
 	static void hard(code_type *b, complex_type c)
@@ -82,6 +80,19 @@ struct PhaseShiftKeying<4, TYPE, CODE>
 		b[1] = quantize(precision, c.imag());
 	}
 
+	template <int WIDTH>
+	static void soft(SIMD<code_type, 4 * WIDTH> *b, const SIMD<value_type, WIDTH> *re, const SIMD<value_type, WIDTH> *im, value_type precision)
+	{
+		typedef SIMD<value_type, WIDTH> vec;
+		vec tmp[BITS][4];
+		for (int i = 0; i < 4; ++i) {
+			tmp[0][i] = re[i];
+			tmp[1][i] = im[i];
+		}
+		for (int k = 0; k < BITS; ++k)
+			b[k] = ::quantize<code_type>(DIST * precision, tmp[k]);
+	}
+
 	static complex_type map(code_type *b)
 	{
 		return rcp_sqrt_2 * complex_type(b[0], b[1]);
@@ -111,12 +122,7 @@ struct PhaseShiftKeying<8, TYPE, CODE>
 
 	static code_type quantize(value_type precision, value_type value)
 	{
-		value *= DIST * precision;
-		if (std::is_integral<code_type>::value)
-			value = std::nearbyint(value);
-		if (std::is_same<code_type, int8_t>::value)
-			value = std::min<value_type>(std::max<value_type>(value, -128), 127);
-		return value;
+		return ::quantize<code_type>(DIST * precision, value);
 	}
 
 	static void hard(code_type *b, complex_type c)
@@ -135,6 +141,22 @@ struct PhaseShiftKeying<8, TYPE, CODE>
 		b[0] = quantize(precision, rcp_sqrt_2 * (std::abs(c.real()) - std::abs(c.imag())));
 	}
 
+	template <int WIDTH>
+	static void soft(SIMD<code_type, 4 * WIDTH> *b, const SIMD<value_type, WIDTH> *re, const SIMD<value_type, WIDTH> *im, value_type precision)
+	{
+		typedef SIMD<value_type, WIDTH> vec;
+		vec tmp[BITS][4];
+		for (int i = 0; i < 4; ++i) {
+			vec x = vadd(vmul(re[i], vdup<vec>(cos_pi_8)), vmul(im[i], vdup<vec>(sin_pi_8)));
+			vec y = vsub(vmul(im[i], vdup<vec>(cos_pi_8)), vmul(re[i], vdup<vec>(sin_pi_8)));
+			tmp[1][i] = x;
+			tmp[2][i] = y;
+			tmp[0][i] = vmul(vdup<vec>(rcp_sqrt_2), vsub(vabs(x), vabs(y)));
+		}
+		for (int k = 0; k < BITS; ++k)
+			b[k] = ::quantize<code_type>(DIST * precision, tmp[k]);
+	}
+
 	static complex_type map(code_type *b)
 	{
 		value_type real = cos_pi_8;
@@ -7,6 +7,8 @@ Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
 #ifndef QAM_HH
 #define QAM_HH
 
+#include "quantize.hh"
+
 template <int NUM, typename TYPE, typename CODE>
 struct QuadratureAmplitudeModulation;
 
@@ -31,12 +33,7 @@ struct QuadratureAmplitudeModulation<16, TYPE, CODE>
 
 	static code_type quantize(value_type precision, value_type value)
 	{
-		value *= DIST * precision;
-		if (std::is_integral<code_type>::value)
-			value = std::nearbyint(value);
-		if (std::is_same<code_type, int8_t>::value)
-			value = std::min<value_type>(std::max<value_type>(value, -128), 127);
-		return value;
+		return ::quantize<code_type>(DIST * precision, value);
 	}
 
 	static void hard(code_type *b, complex_type c)
@@ -55,6 +52,21 @@ struct QuadratureAmplitudeModulation<16, TYPE, CODE>
 		b[3] = quantize(precision, std::abs(c.imag())-amp(2));
 	}
 
+	template <int WIDTH>
+	static void soft(SIMD<code_type, 4 * WIDTH> *b, const SIMD<value_type, WIDTH> *re, const SIMD<value_type, WIDTH> *im, value_type precision)
+	{
+		typedef SIMD<value_type, WIDTH> vec;
+		vec tmp[BITS][4];
+		for (int i = 0; i < 4; ++i) {
+			tmp[0][i] = re[i];
+			tmp[1][i] = im[i];
+			tmp[2][i] = vsub(vabs(tmp[0][i]), vdup<vec>(amp(2)));
+			tmp[3][i] = vsub(vabs(tmp[1][i]), vdup<vec>(amp(2)));
+		}
+		for (int k = 0; k < BITS; ++k)
+			b[k] = ::quantize<code_type>(DIST * precision, tmp[k]);
+	}
+
 	static complex_type map(code_type *b)
 	{
 		return AMP * complex_type(
@@ -85,12 +97,7 @@ struct QuadratureAmplitudeModulation<64, TYPE, CODE>
 
 	static code_type quantize(value_type precision, value_type value)
 	{
-		value *= DIST * precision;
-		if (std::is_integral<code_type>::value)
-			value = std::nearbyint(value);
-		if (std::is_same<code_type, int8_t>::value)
-			value = std::min<value_type>(std::max<value_type>(value, -128), 127);
-		return value;
+		return ::quantize<code_type>(DIST * precision, value);
 	}
 
 	static void hard(code_type *b, complex_type c)
@@ -113,6 +120,23 @@ struct QuadratureAmplitudeModulation<64, TYPE, CODE>
 		b[5] = quantize(precision, std::abs(std::abs(c.imag())-amp(4))-amp(2));
 	}
 
+	template <int WIDTH>
+	static void soft(SIMD<code_type, 4 * WIDTH> *b, const SIMD<value_type, WIDTH> *re, const SIMD<value_type, WIDTH> *im, value_type precision)
+	{
+		typedef SIMD<value_type, WIDTH> vec;
+		vec tmp[BITS][4];
+		for (int i = 0; i < 4; ++i) {
+			tmp[0][i] = re[i];
+			tmp[1][i] = im[i];
+			tmp[2][i] = vsub(vabs(tmp[0][i]), vdup<vec>(amp(4)));
+			tmp[3][i] = vsub(vabs(tmp[1][i]), vdup<vec>(amp(4)));
+			tmp[4][i] = vsub(vabs(tmp[2][i]), vdup<vec>(amp(2)));
+			tmp[5][i] = vsub(vabs(tmp[3][i]), vdup<vec>(amp(2)));
+		}
+		for (int k = 0; k < BITS; ++k)
+			b[k] = ::quantize<code_type>(DIST * precision, tmp[k]);
+	}
+
 	static complex_type map(code_type *b)
 	{
 		return AMP * complex_type(
@@ -143,12 +167,7 @@ struct QuadratureAmplitudeModulation<256, TYPE, CODE>
 
 	static code_type quantize(value_type precision, value_type value)
 	{
-		value *= DIST * precision;
-		if (std::is_integral<code_type>::value)
-			value = std::nearbyint(value);
-		if (std::is_same<code_type, int8_t>::value)
-			value = std::min<value_type>(std::max<value_type>(value, -128), 127);
-		return value;
+		return ::quantize<code_type>(DIST * precision, value);
 	}
 
 	static void hard(code_type *b, complex_type c)
@@ -175,6 +194,25 @@ struct QuadratureAmplitudeModulation<256, TYPE, CODE>
 		b[7] = quantize(precision, std::abs(std::abs(std::abs(c.imag())-amp(8))-amp(4))-amp(2));
 	}
 
+	template <int WIDTH>
+	static void soft(SIMD<code_type, 4 * WIDTH> *b, const SIMD<value_type, WIDTH> *re, const SIMD<value_type, WIDTH> *im, value_type precision)
+	{
+		typedef SIMD<value_type, WIDTH> vec;
+		vec tmp[BITS][4];
+		for (int i = 0; i < 4; ++i) {
+			tmp[0][i] = re[i];
+			tmp[1][i] = im[i];
+			tmp[2][i] = vsub(vabs(tmp[0][i]), vdup<vec>(amp(8)));
+			tmp[3][i] = vsub(vabs(tmp[1][i]), vdup<vec>(amp(8)));
+			tmp[4][i] = vsub(vabs(tmp[2][i]), vdup<vec>(amp(4)));
+			tmp[5][i] = vsub(vabs(tmp[3][i]), vdup<vec>(amp(4)));
+			tmp[6][i] = vsub(vabs(tmp[4][i]), vdup<vec>(amp(2)));
+			tmp[7][i] = vsub(vabs(tmp[5][i]), vdup<vec>(amp(2)));
+		}
+		for (int k = 0; k < BITS; ++k)
+			b[k] = ::quantize<code_type>(DIST * precision, tmp[k]);
+	}
+
 	static complex_type map(code_type *b)
 	{
 		return AMP * complex_type(
@@ -205,12 +243,7 @@ struct QuadratureAmplitudeModulation<1024, TYPE, CODE>
 
 	static code_type quantize(value_type precision, value_type value)
 	{
-		value *= DIST * precision;
-		if (std::is_integral<code_type>::value)
-			value = std::nearbyint(value);
-		if (std::is_same<code_type, int8_t>::value)
-			value = std::min<value_type>(std::max<value_type>(value, -128), 127);
-		return value;
+		return ::quantize<code_type>(DIST * precision, value);
 	}
 
 	static void hard(code_type *b, complex_type c)
@@ -241,6 +274,27 @@ struct QuadratureAmplitudeModulation<1024, TYPE, CODE>
 		b[9] = quantize(precision, std::abs(std::abs(std::abs(std::abs(c.imag())-amp(16))-amp(8))-amp(4))-amp(2));
 	}
 
+	template <int WIDTH>
+	static void soft(SIMD<code_type, 4 * WIDTH> *b, const SIMD<value_type, WIDTH> *re, const SIMD<value_type, WIDTH> *im, value_type precision)
+	{
+		typedef SIMD<value_type, WIDTH> vec;
+		vec tmp[BITS][4];
+		for (int i = 0; i < 4; ++i) {
+			tmp[0][i] = re[i];
+			tmp[1][i] = im[i];
+			tmp[2][i] = vsub(vabs(tmp[0][i]), vdup<vec>(amp(16)));
+			tmp[3][i] = vsub(vabs(tmp[1][i]), vdup<vec>(amp(16)));
+			tmp[4][i] = vsub(vabs(tmp[2][i]), vdup<vec>(amp(8)));
+			tmp[5][i] = vsub(vabs(tmp[3][i]), vdup<vec>(amp(8)));
+			tmp[6][i] = vsub(vabs(tmp[4][i]), vdup<vec>(amp(4)));
+			tmp[7][i] = vsub(vabs(tmp[5][i]), vdup<vec>(amp(4)));
+			tmp[8][i] = vsub(vabs(tmp[6][i]), vdup<vec>(amp(2)));
+			tmp[9][i] = vsub(vabs(tmp[7][i]), vdup<vec>(amp(2)));
+		}
+		for (int k = 0; k < BITS; ++k)
+			b[k] = ::quantize<code_type>(DIST * precision, tmp[k]);
+	}
+
 	static complex_type map(code_type *b)
 	{
 		return AMP * complex_type(
@@ -0,0 +1,41 @@
+/*
+Quantization of soft bits
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#ifndef QUANTIZE_HH
+#define QUANTIZE_HH
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <type_traits>
+#include "simd.hh"
+
+// scale and, for integer codes, round to nearest and saturate
+template <typename CODE, typename VALUE>
+static inline CODE quantize(VALUE factor, VALUE value)
+{
+	value *= factor;
+	if (std::is_integral<CODE>::value) {
+		value = std::nearbyint(value);
+		value = std::min<VALUE>(std::max<VALUE>(value, std::numeric_limits<CODE>::min()), std::numeric_limits<CODE>::max());
+	}
+	return value;
+}
+
+// same for four vectors at once, narrowed into the lanes of one
+template <typename CODE, typename VALUE, int WIDTH>
+static inline SIMD<CODE, 4 * WIDTH> quantize(VALUE factor, const SIMD<VALUE, WIDTH> *value)
+{
+	static_assert(std::is_same<CODE, int8_t>::value, "narrowing four to one only fits int8_t codes");
+	typedef SIMD<VALUE, WIDTH> vec;
+	vec fac = vdup<vec>(factor);
+	SIMD<int32_t, WIDTH> tmp[4];
+	for (int i = 0; i < 4; ++i)
+		tmp[i] = vcvtn(vclamp(vmul(value[i], fac), VALUE(std::numeric_limits<CODE>::min()), VALUE(std::numeric_limits<CODE>::max())));
+	return vqmovn(vqmovn(tmp[0], tmp[1]), vqmovn(tmp[2], tmp[3]));
+}
+
+#endif
@@ -0,0 +1,331 @@
+/*
+LDPC SISO quasi-cyclic layered decoder
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#ifndef QUASI_CYCLIC_DECODER_HH
+#define QUASI_CYCLIC_DECODER_HH
+
+#include <cstring>
+#include <limits>
+#include "graph.hh"
+
+template <typename TYPE, typename ALG>
+class LDPCQuasiCyclicDecoder
+{
+	typedef typename TYPE::value_type value_type;
+	typedef SIMD<typename TYPE::uint_type, TYPE::SIZE> mask_type;
+	static const int WIDTH = TYPE::SIZE;
+	static_assert(WIDTH <= 64, "lanes are tracked in 64 bit masks");
+	// a link vector wrapping around its group or with unused lanes reads lanes lo+l before
+	// and hi+l after the wrap, masks[msk] selects those lanes and masks[msk+2] the unused ones
+	struct Split
+	{
+		int lo, hi, msk;
+	};
+	TYPE *bnl;
+	value_type *mem, *buf;
+	int *off;
+	Split *split;
+	mask_type *masks, *subm;
+	uint8_t *cnc, *subs;
+	ALG alg;
+	int M, N, K, R, q, C, LT;
+	bool initialized;
+
+	void reset()
+	{
+		for (int i = 0; i < LT; ++i)
+			bnl[i] = alg.zero();
+	}
+	TYPE load(int o)
+	{
+		TYPE tmp;
+		if (o >= 0) {
+			std::memcpy(&tmp, buf+o, sizeof(TYPE));
+		} else {
+			const Split &sp = split[-o-1];
+			const mask_type *ms = masks + sp.msk;
+			TYPE lo, hi;
+			std::memcpy(&lo, buf+sp.lo, sizeof(TYPE));
+			std::memcpy(&hi, buf+sp.hi, sizeof(TYPE));
+			tmp = vreinterpret<TYPE>(vbsl(ms[0], vmask(lo), vmask(hi)));
+			tmp = vreinterpret<TYPE>(vbsl(ms[2], vmask(vdup<TYPE>(std::numeric_limits<value_type>::max())), vmask(tmp)));
+		}
+		return tmp;
+	}
+	void blend(int o, TYPE val, mask_type msk)
+	{
+		TYPE tmp;
+		std::memcpy(&tmp, buf+o, sizeof(TYPE));
+		tmp = vreinterpret<TYPE>(vbsl(msk, vmask(val), vmask(tmp)));
+		std::memcpy(buf+o, &tmp, sizeof(TYPE));
+	}
+	void store(int o, TYPE val, TYPE *bl)
+	{
+		if (o >= 0) {
+			std::memcpy(buf+o, &val, sizeof(TYPE));
+		} else {
+			const Split &sp = split[-o-1];
+			const mask_type *ms = masks + sp.msk;
+			blend(sp.lo, val, ms[0]);
+			if (sp.hi != sp.lo)
+				blend(sp.hi, val, ms[1]);
+			*bl = vreinterpret<TYPE>(vbic(vmask(*bl), ms[2]));
+		}
+	}
+	// commit only the lanes of the sub-layer selected by sub
+	void store(int o, TYPE val, TYPE *bl, TYPE msg, mask_type sub)
+	{
+		*bl = vreinterpret<TYPE>(vbsl(sub, vmask(msg), vmask(*bl)));
+		if (o >= 0) {
+			blend(o, val, sub);
+		} else {
+			const Split &sp = split[-o-1];
+			const mask_type *ms = masks + sp.msk;
+			blend(sp.lo, val, vand(ms[0], sub));
+			if (sp.hi != sp.lo)
+				blend(sp.hi, val, vand(ms[1], sub));
+			*bl = vreinterpret<TYPE>(vbic(vmask(*bl), ms[2]));
+		}
+	}
+	bool bad()
+	{
+		int *of = off;
+		for (int i = 0; i < q; ++i) {
+			int deg = cnc[i] + 2;
+			TYPE acc = alg.one();
+			for (int k = 0; k < C; ++k) {
+				TYPE cnv = alg.one();
+				for (int d = 0; d < deg; ++d)
+					cnv = alg.sign(cnv, load(of[d]));
+				acc = alg.sign(alg.sign(acc, alg.add(cnv, alg.one())), cnv);
+				of += deg;
+			}
+			if (alg.bad(acc, WIDTH))
+				return true;
+		}
+		return false;
+	}
+	void update()
+	{
+		TYPE *bl = bnl;
+		int *of = off;
+		uint8_t *sb = subs;
+		mask_type *sm = subm;
+		for (int i = 0; i < q; ++i) {
+			int deg = cnc[i] + 2;
+			for (int k = 0; k < C; ++k, ++sb) {
+				TYPE inp[deg], out[deg];
+				if (*sb == 1) {
+					for (int d = 0; d < deg; ++d)
+						inp[d] = out[d] = alg.sub(load(of[d]), bl[d]);
+					alg.finalp(out, deg);
+					for (int d = 0; d < deg; ++d)
+						alg.update(bl+d, out[d]);
+					for (int d = 0; d < deg; ++d)
+						store(of[d], alg.add(inp[d], bl[d]), bl+d);
+				} else {
+					for (int s = 0; s < *sb; ++s) {
+						for (int d = 0; d < deg; ++d)
+							inp[d] = out[d] = alg.sub(load(of[d]), bl[d]);
+						alg.finalp(out, deg);
+						for (int d = 0; d < deg; ++d) {
+							TYPE msg = bl[d];
+							alg.update(&msg, out[d]);
+							store(of[d], alg.add(inp[d], msg), bl+d, msg, sm[s]);
+						}
+					}
+					sm += *sb;
+				}
+				bl += deg;
+				of += deg;
+			}
+		}
+	}
+public:
+	LDPCQuasiCyclicDecoder() : initialized(false)
+	{
+	}
+	void init(LDPCInterface *it)
+	{
+		const LDPCGraph *graph = LDPCGraph::acquire(it);
+		init(graph);
+		LDPCGraph::release(graph);
+	}
+	void init(const LDPCGraph *graph)
+	{
+		if (initialized) {
+			delete[] bnl;
+			delete[] mem;
+			delete[] off;
+			delete[] split;
+			delete[] masks;
+			delete[] subm;
+			delete[] cnc;
+			delete[] subs;
+		}
+		initialized = true;
+		N = graph->code_len();
+		K = graph->data_len();
+		M = graph->group_len();
+		R = N - K;
+		q = R / M;
+		C = (M + WIDTH - 1) / WIDTH;
+		const int NEU = N;
+		cnc = new uint8_t[R];
+		for (int i = 0; i < R; ++i)
+			cnc[i] = graph->check_deg(i);
+		LT = 0;
+		for (int i = 0; i < q; ++i)
+			LT += C * (cnc[i] + 2);
+		bnl = new TYPE[LT];
+		// lo+l and hi+l may reach up to a vector before and after the code word
+		mem = new value_type[WIDTH + N + WIDTH]();
+		buf = mem + WIDTH;
+		off = new int[LT];
+		subs = new uint8_t[q * C];
+		Split *sp = new Split[LT];
+		mask_type *ms = new mask_type[3 * LT];
+		mask_type *sm = new mask_type[q * C * WIDTH];
+		int *pos = new int[graph->links_max_cn() * WIDTH];
+		uint64_t *users = new uint64_t[N + 1]();
+		uint8_t sl[WIDTH];
+		int *of = off, nsp = 0, nms = 0, nsm = 0;
+		uint8_t *sb = subs;
+		for (int i = 0; i < q; ++i) {
+			int cnt = cnc[i];
+			for (int k = 0; k < C; ++k, ++sb) {
+				int j0 = WIDTH * k;
+				for (int d = 0; d < cnt + 2; ++d) {
+					for (int l = 0; l < WIDTH; ++l) {
+						int j = j0 + l, x = NEU;
+						if (j < M && d < cnt) {
+							int b = graph->check_pos(q*j0+i)[d];
+							int g = b - b % M;
+							x = g + (b - g + l) % M;
+						} else if (j < M && d == cnt) {
+							x = K + M * i + j;
+						} else if (j < M && i) {
+							x = K + M * (i - 1) + j;
+						} else if (j < M && j) {
+							x = K + M * (q - 1) + j - 1;
+						}
+						pos[WIDTH*d+l] = x;
+						if (x != NEU)
+							users[x] |= uint64_t(1) << l;
+					}
+				}
+				// two entries of a row in the same group D < WIDTH apart make checks j and j+D share a bit node,
+				// so lanes of the same vector sharing a bit node go into sub-layers updated one after another
+				*sb = 1;
+				for (int l = 0; l < WIDTH; ++l) {
+					uint64_t mask = 0;
+					for (int d = 0; d < cnt + 2; ++d)
+						if (pos[WIDTH*d+l] != NEU)
+							mask |= users[pos[WIDTH*d+l]];
+					mask &= (uint64_t(1) << l) - 1;
+					uint64_t used = 0;
+					for (int m = 0; m < l; ++m)
+						if ((mask >> m) & 1)
+							used |= uint64_t(1) << sl[m];
+					int s = 0;
+					while ((used >> s) & 1)
+						++s;
+					sl[l] = s;
+					if (s >= *sb)
+						*sb = s + 1;
+				}
+				if (*sb > 1) {
+					for (int s = 0; s < *sb; ++s, ++nsm)
+						for (int l = 0; l < WIDTH; ++l)
+							sm[nsm].v[l] = sl[l] == s ? ~0 : 0;
+				}
+				for (int d = 0; d < cnt + 2; ++d) {
+					int *ps = pos + WIDTH * d;
+					for (int l = 0; l < WIDTH; ++l)
+						if (ps[l] != NEU)
+							users[ps[l]] = 0;
+					// lanes follow lo+l up to the wrap and hi+l after it
+					int lo = 0, hi = 0, w = 0;
+					while (w < WIDTH && ps[w] == NEU)
+						++w;
+					if (w < WIDTH)
+						lo = hi = ps[w] - w;
+					while (w < WIDTH && (ps[w] == NEU || ps[w] == lo + w))
+						++w;
+					if (w < WIDTH)
+						hi = ps[w] - w;
+					mask_type tmp[3];
+					bool ctg = true;
+					for (int l = 0; l < WIDTH; ++l) {
+						bool neu = ps[l] == NEU, fst = !neu && ps[l] == lo + l;
+						tmp[0].v[l] = fst ? ~0 : 0;
+						tmp[1].v[l] = !neu && !fst ? ~0 : 0;
+						tmp[2].v[l] = neu ? ~0 : 0;
+						ctg = ctg && fst;
+					}
+					if (ctg) {
+						*of++ = lo;
+						continue;
+					}
+					int m = 0;
+					while (m < nms && std::memcmp(ms + m, tmp, sizeof(tmp)))
+						m += 3;
+					if (m == nms) {
+						std::memcpy(ms + m, tmp, sizeof(tmp));
+						nms += 3;
+					}
+					sp[nsp].lo = lo;
+					sp[nsp].hi = hi;
+					sp[nsp].msk = m;
+					*of++ = -++nsp;
+				}
+			}
+		}
+		split = new Split[nsp];
+		std::memcpy(split, sp, sizeof(Split) * nsp);
+		masks = new mask_type[nms];
+		std::memcpy(masks, ms, sizeof(mask_type) * nms);
+		subm = new mask_type[nsm];
+		std::memcpy(subm, sm, sizeof(mask_type) * nsm);
+		delete[] sp;
+		delete[] ms;
+		delete[] sm;
+		delete[] pos;
+		delete[] users;
+	}
+	int operator()(value_type *data, value_type *parity, int trials = 25)
+	{
+		reset();
+		for (int i = 0; i < K; ++i)
+			buf[i] = data[i];
+		for (int i = 0; i < q; ++i)
+			for (int j = 0; j < M; ++j)
+				buf[K+M*i+j] = parity[q*j+i];
+		while (bad() && --trials >= 0)
+			update();
+		for (int i = 0; i < K; ++i)
+			data[i] = buf[i];
+		for (int i = 0; i < q; ++i)
+			for (int j = 0; j < M; ++j)
+				parity[q*j+i] = buf[K+M*i+j];
+		return trials;
+	}
+	~LDPCQuasiCyclicDecoder()
+	{
+		if (initialized) {
+			delete[] bnl;
+			delete[] mem;
+			delete[] off;
+			delete[] split;
+			delete[] masks;
+			delete[] subm;
+			delete[] cnc;
+			delete[] subs;
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,119 @@
+/*
+Scheduler grouping frames of mixed codes into SIMD batches
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#ifndef SCHEDULER_HH
+#define SCHEDULER_HH
+
+#include <chrono>
+#include <algorithm>
+#include "transpose.hh"
+#include "multi_decoder.hh"
+
+template <typename TYPE, typename ALG>
+class LDPCScheduler
+{
+	typedef typename TYPE::value_type code_type;
+	typedef std::chrono::steady_clock clock;
+	static const int WIDTH = TYPE::SIZE;
+	struct Queue
+	{
+		code_type *frames[WIDTH];
+		int *counts[WIDTH];
+		clock::time_point oldest;
+		int fill;
+	};
+	LDPCMultiDecoder<TYPE, ALG> decode;
+	Queue *queues;
+	TYPE *simd;
+	clock::duration latency;
+	int num, trials, batches;
+	bool initialized;
+
+	int run(int code)
+	{
+		Queue *q = queues + code;
+		int N = decode.code_len(code);
+		int K = decode.data_len(code);
+		int counts[WIDTH];
+		pack(simd, q->frames, N, q->fill);
+		decode(code, counts, simd, simd + K, trials, q->fill);
+		unpack(q->frames, simd, N, q->fill);
+		for (int n = 0; n < q->fill; ++n)
+			*q->counts[n] = counts[n];
+		int done = q->fill;
+		q->fill = 0;
+		++batches;
+		return done;
+	}
+public:
+	LDPCScheduler() : initialized(false)
+	{
+	}
+	void init(LDPCInterface **codes, int count, std::chrono::microseconds deadline, int iterations = 25)
+	{
+		if (initialized) {
+			delete[] queues;
+			delete[] simd;
+		}
+		initialized = true;
+		decode.init(codes, count);
+		num = count;
+		latency = deadline;
+		trials = iterations;
+		batches = 0;
+		queues = new Queue[num];
+		int N = 0;
+		for (int n = 0; n < num; ++n) {
+			queues[n].fill = 0;
+			N = std::max(N, decode.code_len(n));
+		}
+		simd = new TYPE[N];
+	}
+	int decodes()
+	{
+		return batches;
+	}
+	// frame gets decoded in place and count set to the trials left, returns number of frames finished
+	int push(int code, code_type *frame, int *count)
+	{
+		Queue *q = queues + code;
+		if (!q->fill)
+			q->oldest = clock::now();
+		q->frames[q->fill] = frame;
+		q->counts[q->fill] = count;
+		int done = 0;
+		if (++q->fill == WIDTH)
+			done += run(code);
+		return done + poll();
+	}
+	// decode partial batches whose oldest frame has been waiting longer than the deadline
+	int poll()
+	{
+		clock::time_point now = clock::now();
+		int done = 0;
+		for (int n = 0; n < num; ++n)
+			if (queues[n].fill && now - queues[n].oldest >= latency)
+				done += run(n);
+		return done;
+	}
+	int flush()
+	{
+		int done = 0;
+		for (int n = 0; n < num; ++n)
+			if (queues[n].fill)
+				done += run(n);
+		return done;
+	}
+	~LDPCScheduler()
+	{
+		if (initialized) {
+			delete[] queues;
+			delete[] simd;
+		}
+	}
+};
+
+#endif
@@ -1495,7 +1495,82 @@ static inline SIMD<double, WIDTH> vshuf(SIMD<double, WIDTH> a, SIMD<uint64_t, WI
 	return tmp;
 }
 
+template <int WIDTH>
+static inline SIMD<int32_t, WIDTH> vcvtn(SIMD<float, WIDTH> a)
+{
+	SIMD<int32_t, WIDTH> tmp;
+	for (int i = 0; i < WIDTH; ++i)
+		tmp.v[i] = std::nearbyint(a.v[i]);
+	return tmp;
+}
+
+template <int WIDTH>
+static inline SIMD<float, WIDTH> vcvt(SIMD<int32_t, WIDTH> a)
+{
+	SIMD<float, WIDTH> tmp;
+	for (int i = 0; i < WIDTH; ++i)
+		tmp.v[i] = a.v[i];
+	return tmp;
+}
+
+template <int WIDTH>
+static inline SIMD<int16_t, 2 * WIDTH> vqmovn(SIMD<int32_t, WIDTH> a, SIMD<int32_t, WIDTH> b)
+{
+	SIMD<int16_t, 2 * WIDTH> tmp;
+	for (int i = 0; i < WIDTH; ++i) {
+		tmp.v[i] = std::min<int32_t>(std::max<int32_t>(a.v[i], -32768), 32767);
+		tmp.v[WIDTH+i] = std::min<int32_t>(std::max<int32_t>(b.v[i], -32768), 32767);
+	}
+	return tmp;
+}
+
+template <int WIDTH>
+static inline SIMD<int8_t, 2 * WIDTH> vqmovn(SIMD<int16_t, WIDTH> a, SIMD<int16_t, WIDTH> b)
+{
+	SIMD<int8_t, 2 * WIDTH> tmp;
+	for (int i = 0; i < WIDTH; ++i) {
+		tmp.v[i] = std::min<int16_t>(std::max<int16_t>(a.v[i], -128), 127);
+		tmp.v[WIDTH+i] = std::min<int16_t>(std::max<int16_t>(b.v[i], -128), 127);
+	}
+	return tmp;
+}
+
+template <typename TYPE, int WIDTH>
+static inline SIMD<TYPE, WIDTH> vzip1(SIMD<TYPE, WIDTH> a, SIMD<TYPE, WIDTH> b)
+{
+	SIMD<TYPE, WIDTH> tmp;
+	for (int i = 0; i < WIDTH / 2; ++i) {
+		tmp.v[2*i] = a.v[i];
+		tmp.v[2*i+1] = b.v[i];
+	}
+	return tmp;
+}
+
+template <typename TYPE, int WIDTH>
+static inline SIMD<TYPE, WIDTH> vzip2(SIMD<TYPE, WIDTH> a, SIMD<TYPE, WIDTH> b)
+{
+	SIMD<TYPE, WIDTH> tmp;
+	for (int i = 0; i < WIDTH / 2; ++i) {
+		tmp.v[2*i] = a.v[WIDTH/2+i];
+		tmp.v[2*i+1] = b.v[WIDTH/2+i];
+	}
+	return tmp;
+}
+
+template <typename TYPE, int WIDTH>
+static inline uint64_t vmovemask(SIMD<TYPE, WIDTH> a)
+{
+	uint64_t tmp = 0;
+	for (int i = 0; i < WIDTH; ++i)
+		tmp |= uint64_t(a.v[i] >> (sizeof(TYPE) * 8 - 1)) << i;
+	return tmp;
+}
+
 #if 1
+#ifdef __AVX512BW__
+#include "avx512.hh"
+#endif
+
 #ifdef __AVX2__
 #include "avx2.hh"
 #else
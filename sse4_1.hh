@@ -470,6 +470,14 @@ inline SIMD<double, 2> vmul(SIMD<double, 2> a, SIMD<double, 2> b)
 	return tmp;
 }
 
+template <>
+inline SIMD<float, 4> vneg(SIMD<float, 4> a)
+{
+	SIMD<float, 4> tmp;
+	tmp.m = _mm_xor_ps(_mm_set1_ps(-0.f), a.m);
+	return tmp;
+}
+
 template <>
 inline SIMD<float, 4> vabs(SIMD<float, 4> a)
 {
@@ -1165,3 +1173,84 @@ inline SIMD<int8_t, 16> vshuf(SIMD<int8_t, 16> a, SIMD<uint8_t, 16> b)
 	return tmp;
 }
 
+template <>
+inline SIMD<int32_t, 4> vcvtn(SIMD<float, 4> a)
+{
+	SIMD<int32_t, 4> tmp;
+	tmp.m = _mm_cvtps_epi32(a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<float, 4> vcvt(SIMD<int32_t, 4> a)
+{
+	SIMD<float, 4> tmp;
+	tmp.m = _mm_cvtepi32_ps(a.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 8> vqmovn(SIMD<int32_t, 4> a, SIMD<int32_t, 4> b)
+{
+	SIMD<int16_t, 8> tmp;
+	tmp.m = _mm_packs_epi32(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 16> vqmovn(SIMD<int16_t, 8> a, SIMD<int16_t, 8> b)
+{
+	SIMD<int8_t, 16> tmp;
+	tmp.m = _mm_packs_epi16(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 16> vzip1(SIMD<int8_t, 16> a, SIMD<int8_t, 16> b)
+{
+	SIMD<int8_t, 16> tmp;
+	tmp.m = _mm_unpacklo_epi8(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int8_t, 16> vzip2(SIMD<int8_t, 16> a, SIMD<int8_t, 16> b)
+{
+	SIMD<int8_t, 16> tmp;
+	tmp.m = _mm_unpackhi_epi8(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 8> vzip1(SIMD<int16_t, 8> a, SIMD<int16_t, 8> b)
+{
+	SIMD<int16_t, 8> tmp;
+	tmp.m = _mm_unpacklo_epi16(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline SIMD<int16_t, 8> vzip2(SIMD<int16_t, 8> a, SIMD<int16_t, 8> b)
+{
+	SIMD<int16_t, 8> tmp;
+	tmp.m = _mm_unpackhi_epi16(a.m, b.m);
+	return tmp;
+}
+
+template <>
+inline uint64_t vmovemask(SIMD<uint8_t, 16> a)
+{
+	return _mm_movemask_epi8(a.m);
+}
+
+template <>
+inline uint64_t vmovemask(SIMD<uint16_t, 8> a)
+{
+	return _mm_movemask_epi8(_mm_packs_epi16(a.m, _mm_setzero_si128()));
+}
+
+template <>
+inline uint64_t vmovemask(SIMD<uint32_t, 4> a)
+{
+	return _mm_movemask_ps(_mm_castsi128_ps(a.m));
+}
@@ -0,0 +1,147 @@
+/*
+LDPC SISO layered decoder specialized for one table at compile time
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#ifndef TABLE_DECODER_HH
+#define TABLE_DECODER_HH
+
+#include "ldpc.hh"
+
+template <typename TABLE, typename TYPE, typename ALG>
+class LDPCTableDecoder
+{
+	static const int M = TABLE::M;
+	static const int N = TABLE::N;
+	static const int K = TABLE::K;
+	static const int R = N - K;
+	static const int q = R / M;
+	static const int CNL = TABLE::LINKS_MAX_CN - 2;
+	static const int CNMIN = TABLE::LINKS_MIN_CN - 2;
+	static const int LT = TABLE::LINKS_TOTAL;
+	static constexpr LDPCLayered<TABLE> LAYERED = LDPCLayered<TABLE>();
+	static constexpr const uint16_t *pos = LAYERED.pos;
+	static constexpr const uint8_t *cnc = LAYERED.cnc;
+	TYPE *bnl, *pty;
+	ALG alg;
+	bool initialized;
+
+	template <int CNT>
+	bool bad(TYPE *data, TYPE *parity, int blocks, int i)
+	{
+		const uint16_t *p = pos + CNL * M * i;
+		TYPE acc = alg.one();
+		for (int j = 0; j < M; ++j, p += CNL) {
+			TYPE cnv = alg.sign(alg.one(), parity[M*i+j]);
+			if (i)
+				cnv = alg.sign(cnv, parity[M*(i-1)+j]);
+			else if (j)
+				cnv = alg.sign(cnv, parity[j+(q-1)*M-1]);
+			for (int c = 0; c < CNT; ++c)
+				cnv = alg.sign(cnv, data[p[c]]);
+			acc = alg.sign(alg.sign(acc, alg.add(cnv, alg.one())), cnv);
+		}
+		return alg.bad(acc, blocks);
+	}
+	template <int CNT>
+	bool bad_dispatch(TYPE *data, TYPE *parity, int blocks, int i)
+	{
+		if (cnc[i] == CNT)
+			return bad<CNT>(data, parity, blocks, i);
+		if constexpr (CNT > CNMIN)
+			return bad_dispatch<CNT-1>(data, parity, blocks, i);
+		return false;
+	}
+	bool bad(TYPE *data, TYPE *parity, int blocks)
+	{
+		for (int i = 0; i < q; ++i)
+			if (bad_dispatch<CNL>(data, parity, blocks, i))
+				return true;
+		return false;
+	}
+	template <int CNT, int DEG>
+	void check(TYPE *data, TYPE *par0, TYPE *par1, TYPE *bl, const uint16_t *p)
+	{
+		TYPE inp[DEG], out[DEG];
+		for (int c = 0; c < CNT; ++c)
+			inp[c] = out[c] = alg.sub(data[p[c]], bl[c]);
+		inp[CNT] = out[CNT] = alg.sub(*par0, bl[CNT]);
+		if constexpr (DEG > CNT + 1)
+			inp[CNT+1] = out[CNT+1] = alg.sub(*par1, bl[CNT+1]);
+		alg.finalp(out, DEG);
+		for (int d = 0; d < DEG; ++d)
+			alg.update(bl+d, out[d]);
+		for (int c = 0; c < CNT; ++c)
+			data[p[c]] = alg.add(inp[c], bl[c]);
+		*par0 = alg.add(inp[CNT], bl[CNT]);
+		if constexpr (DEG > CNT + 1)
+			*par1 = alg.add(inp[CNT+1], bl[CNT+1]);
+	}
+	template <int CNT>
+	TYPE *update(TYPE *data, TYPE *parity, TYPE *bl, int i)
+	{
+		const uint16_t *p = pos + CNL * M * i;
+		int j = 0;
+		// the very first check has no accumulator link to the previous parity bit
+		if (!i) {
+			check<CNT, CNT+1>(data, parity, 0, bl, p);
+			bl += CNT + 1;
+			p += CNL;
+			++j;
+		}
+		for (; j < M; ++j, p += CNL, bl += CNT + 2)
+			check<CNT, CNT+2>(data, parity + M*i+j, i ? parity + M*(i-1)+j : parity + j+(q-1)*M-1, bl, p);
+		return bl;
+	}
+	template <int CNT>
+	TYPE *update_dispatch(TYPE *data, TYPE *parity, TYPE *bl, int i)
+	{
+		if (cnc[i] == CNT)
+			return update<CNT>(data, parity, bl, i);
+		if constexpr (CNT > CNMIN)
+			return update_dispatch<CNT-1>(data, parity, bl, i);
+		return bl;
+	}
+	void update(TYPE *data, TYPE *parity)
+	{
+		TYPE *bl = bnl;
+		for (int i = 0; i < q; ++i)
+			bl = update_dispatch<CNL>(data, parity, bl, i);
+	}
+public:
+	LDPCTableDecoder() : initialized(false)
+	{
+	}
+	void init()
+	{
+		if (initialized)
+			return;
+		initialized = true;
+		bnl = new TYPE[LT];
+		pty = new TYPE[R];
+	}
+	int operator()(TYPE *data, TYPE *parity, int trials = 25, int blocks = 1)
+	{
+		for (int i = 0; i < LT; ++i)
+			bnl[i] = alg.zero();
+		for (int i = 0; i < q; ++i)
+			for (int j = 0; j < M; ++j)
+				pty[M*i+j] = parity[q*j+i];
+		while (bad(data, pty, blocks) && --trials >= 0)
+			update(data, pty);
+		for (int i = 0; i < q; ++i)
+			for (int j = 0; j < M; ++j)
+				parity[q*j+i] = pty[M*i+j];
+		return trials;
+	}
+	~LDPCTableDecoder()
+	{
+		if (initialized) {
+			delete[] bnl;
+			delete[] pty;
+		}
+	}
+};
+
+#endif
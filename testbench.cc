@@ -14,22 +14,40 @@ Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
 #include <algorithm>
 #include <functional>
 #include "testbench.hh"
+#include "transpose.hh"
 #include "encoder.hh"
+#include "packed_encoder.hh"
 #include "algorithms.hh"
 #include "interleaver.hh"
 #include "modulation.hh"
+#include "demapper.hh"
 
 #if 0
 #include "flooding_decoder.hh"
 static const int TRIALS = 50;
+#elif 0
+#include "compressed_decoder.hh"
+static const int TRIALS = 25;
 #else
 #include "layered_decoder.hh"
 static const int TRIALS = 25;
 #endif
+#include "quasi_cyclic_decoder.hh"
+#include "decoder_pool.hh"
+#include "multi_decoder.hh"
+#include "scheduler.hh"
+#include "table_decoder.hh"
+#include "dvb_t2_tables.hh"
+#include "decoder.hh"
 
 LDPCInterface *create_ldpc(char *standard, char prefix, int number);
-Interleaver<code_type> *create_interleaver(char *modulation, char *standard, char prefix, int number);
+Interleaver<code_type> *create_interleaver(char *modulation, char *standard, char prefix, int number, int len);
 ModulationInterface<complex_type, code_type> *create_modulation(char *name, int len);
+DemapperInterface<complex_type, code_type> *create_demapper(char *name, int len);
+DecoderInterface *create_decoder();
+
+// leave code interleaved and deinterleave all SIMD lanes at once after the transpose
+#define DEINTERLEAVE_LANES 0
 
 int main(int argc, char **argv)
 {
@@ -48,6 +66,27 @@ int main(int argc, char **argv)
 
 	LDPCEncoder<code_type> encode;
 	LDPCDecoder<simd_type, algorithm_type> decode;
+#if 0
+	LDPCQuasiCyclicDecoder<simd_type, algorithm_type> qc_decode;
+#endif
+#if 0
+	LDPCDecoderPool<simd_type, algorithm_type> pool;
+#endif
+#if 0
+	LDPCMultiDecoder<simd_type, algorithm_type> multi;
+	int multi_code = 0;
+#endif
+#if 0
+	LDPCScheduler<simd_type, algorithm_type> sched;
+	int sched_code = 0;
+#endif
+#if 0
+	LDPCTableDecoder<DVB_T2_TABLE_A1, simd_type, algorithm_type> table_decode;
+#endif
+#if 0
+	DecoderInterface *dispatch = create_decoder();
+	std::cerr << "using " << dispatch->name() << " decoder with " << dispatch->width() << " lanes." << std::endl;
+#endif
 
 	LDPCInterface *ldpc = create_ldpc(argv[2], argv[3][0], atoi(argv[3]+1));
 	if (!ldpc) {
@@ -60,6 +99,48 @@ int main(int argc, char **argv)
 
 	encode.init(ldpc);
 	decode.init(ldpc);
+#if 0
+	qc_decode.init(ldpc);
+#endif
+#if 0
+	pool.init(ldpc);
+#endif
+#if 0
+	dispatch->init(ldpc);
+#endif
+#if 0
+	if (ldpc->table() != DVB_T2_TABLE_A1::POS) {
+		std::cerr << "table decoder was compiled for another table!" << std::endl;
+		return -1;
+	}
+	table_decode.init();
+#endif
+#if 0
+	{
+		LDPCInterface *codes[32];
+		int count = 0;
+		for (int n = 1; count < 32 && (codes[count] = create_ldpc(argv[2], argv[3][0], n)); ++n, ++count)
+			if (n == atoi(argv[3]+1))
+				multi_code = count;
+		multi.init(codes, count);
+		for (int n = 0; n < count; ++n)
+			delete codes[n];
+		std::cerr << "switching between " << count << " codes." << std::endl;
+	}
+#endif
+#if 0
+	{
+		LDPCInterface *codes[32];
+		int count = 0;
+		for (int n = 1; count < 32 && (codes[count] = create_ldpc(argv[2], argv[3][0], n)); ++n, ++count)
+			if (n == atoi(argv[3]+1))
+				sched_code = count;
+		sched.init(codes, count, std::chrono::milliseconds(10), TRIALS);
+		for (int n = 0; n < count; ++n)
+			delete codes[n];
+		std::cerr << "scheduling between " << count << " codes." << std::endl;
+	}
+#endif
 
 	ModulationInterface<complex_type, code_type> *mod = create_modulation(argv[4], CODE_LEN);
 	if (!mod) {
@@ -70,8 +151,25 @@ int main(int argc, char **argv)
 	assert(CODE_LEN % MOD_BITS == 0);
 	const int SYMBOLS = CODE_LEN / MOD_BITS;
 
-	Interleaver<code_type> *itl = create_interleaver(argv[4], argv[2], argv[3][0], atoi(argv[3]+1));
+	Interleaver<code_type> *itl = create_interleaver(argv[4], argv[2], argv[3][0], atoi(argv[3]+1), CODE_LEN);
 	assert(itl);
+#if 0
+	PermutationInterleaver<code_type> *perm = new PermutationInterleaver<code_type>();
+	perm->init(itl, CODE_LEN);
+	delete itl;
+	itl = perm;
+#endif
+#if DEINTERLEAVE_LANES
+	PermutationInterleaver<simd_type> *lanes = new PermutationInterleaver<simd_type>();
+	lanes->init(itl, CODE_LEN);
+	simd_type *lanes_tmp = new simd_type[CODE_LEN];
+	simd_type *lanes_scratch = new simd_type[CODE_LEN];
+#endif
+#if 0
+	DemapperInterface<complex_type, code_type> *demap = create_demapper(argv[4], CODE_LEN);
+	assert(demap);
+	demap->init(itl);
+#endif
 
 	value_type SNR = atof(argv[1]);
 	//value_type mean_signal = 0;
@@ -100,22 +198,54 @@ int main(int argc, char **argv)
 	code_type *orig = new code_type[BLOCKS * CODE_LEN];
 	code_type *noisy = new code_type[BLOCKS * CODE_LEN];
 	complex_type *symb = new complex_type[BLOCKS * SYMBOLS];
+	code_type *scratch = new code_type[CODE_LEN];
 
 	for (int j = 0; j < BLOCKS; ++j)
 		for (int i = 0; i < DATA_LEN; ++i)
 			code[j * CODE_LEN + i] = 1 - 2 * data();
 
+#if 0
+	LDPCPackedEncoder packed_encode;
+	packed_encode.init(ldpc);
+	uint8_t *packed = new uint8_t[CODE_LEN / 8];
+	for (int j = 0; j < BLOCKS; ++j) {
+		for (int i = 0; i < CODE_LEN / 8; ++i)
+			packed[i] = 0;
+		for (int i = 0; i < DATA_LEN; ++i)
+			packed[i/8] |= (code[j * CODE_LEN + i] < 0) << (7 - i % 8);
+		packed_encode(packed, packed + DATA_LEN / 8);
+		for (int i = DATA_LEN; i < CODE_LEN; ++i)
+			code[j * CODE_LEN + i] = 1 - 2 * ((packed[i/8] >> (7 - i % 8)) & 1);
+	}
+	delete[] packed;
+#else
 	for (int j = 0; j < BLOCKS; ++j)
 		encode(code + j * CODE_LEN, code + j * CODE_LEN + DATA_LEN);
+#endif
 
 	for (int i = 0; i < BLOCKS * CODE_LEN; ++i)
 		orig[i] = code[i];
 
+#if 0
+	uint8_t *bits = new uint8_t[2 * CODE_LEN / 8];
+	uint64_t *words = new uint64_t[3 * packed_words(CODE_LEN)];
+	for (int j = 0; j < BLOCKS; ++j) {
+		for (int i = 0; i < CODE_LEN / 8; ++i)
+			bits[i] = 0;
+		for (int i = 0; i < CODE_LEN; ++i)
+			bits[i/8] |= (code[j * CODE_LEN + i] < 0) << (7 - i % 8);
+		itl->fwd(bits + CODE_LEN / 8, bits, words);
+		mod->mapN(symb + j * SYMBOLS, bits + CODE_LEN / 8);
+	}
+	delete[] bits;
+	delete[] words;
+#else
 	for (int i = 0; i < BLOCKS; ++i)
-		itl->fwd(code + i * CODE_LEN);
+		itl->fwd(code + i * CODE_LEN, scratch);
 
 	for (int j = 0; j < BLOCKS; ++j)
 		mod->mapN(symb + j * SYMBOLS, code + j * CODE_LEN);
+#endif
 
 	for (int i = 0; i < BLOCKS * SYMBOLS; ++i)
 		symb[i] += complex_type(awgn(), awgn());
@@ -139,14 +269,26 @@ int main(int argc, char **argv)
 	// $LLR=log(\frac{p(x=+1|y)}{p(x=-1|y)})$
 	// $p(x|\mu,\sigma)=\frac{1}{\sqrt{2\pi}\sigma}}e^{-\frac{(x-\mu)^2}{2\sigma^2}}$
 	value_type precision = FACTOR / (sigma_noise * sigma_noise);
+#if 0
+	// demap in chunks of 90 symbols, as they arrive in the slots of a physical layer frame
+	for (int j = 0; j < BLOCKS; ++j)
+		for (int s = 0; s < SYMBOLS; s += 90)
+			mod->softN(code + j * CODE_LEN + s * MOD_BITS, symb + j * SYMBOLS + s, precision, std::min(90, SYMBOLS - s));
+#else
 	for (int j = 0; j < BLOCKS; ++j)
 		mod->softN(code + j * CODE_LEN, symb + j * SYMBOLS, precision);
+#endif
 
+#if DEINTERLEAVE_LANES
+	for (int i = 0; i < BLOCKS; ++i)
+		itl->bwd(noisy + i * CODE_LEN, code + i * CODE_LEN, scratch);
+#else
 	for (int i = 0; i < BLOCKS; ++i)
-		itl->bwd(code + i * CODE_LEN);
+		itl->bwd(code + i * CODE_LEN, scratch);
 
 	for (int i = 0; i < BLOCKS * CODE_LEN; ++i)
 		noisy[i] = code[i];
+#endif
 
 	for (int i = 0; i < BLOCKS * CODE_LEN; ++i)
 		assert(!std::isnan(code[i]));
@@ -154,17 +296,122 @@ int main(int argc, char **argv)
 	int iterations = 0;
 	int num_decodes = 0;
 	auto start = std::chrono::system_clock::now();
+#if 0
+	for (int j = 0; j < BLOCKS; ++j) {
+		int trials = TRIALS;
+		int count = qc_decode(code + j * CODE_LEN, code + j * CODE_LEN + DATA_LEN, trials);
+		++num_decodes;
+		if (count < 0) {
+			iterations += trials;
+			std::cerr << "decoder failed at converging to a code word!" << std::endl;
+		} else {
+			iterations += trials - count;
+			std::cerr << trials - count << " iterations were needed." << std::endl;
+		}
+	}
+#elif 0
+	int next = 0;
+	num_decodes = decode.stream(
+		[&]() -> code_type * {
+			return next < BLOCKS ? code + next++ * CODE_LEN : 0;
+		},
+		[&](code_type *, int count) {
+			if (count < 0) {
+				iterations += TRIALS;
+				std::cerr << "decoder failed at converging to a code word!" << std::endl;
+			} else {
+				iterations += TRIALS - count;
+				std::cerr << TRIALS - count << " iterations were needed." << std::endl;
+			}
+		}, TRIALS);
+#elif 0
+	int *counts = new int[BLOCKS];
+	for (int j = 0; j < BLOCKS; j += SIMD_WIDTH) {
+		int blocks = j + SIMD_WIDTH > BLOCKS ? BLOCKS - j : SIMD_WIDTH;
+		pool.push(code + j * CODE_LEN, counts + j, blocks, TRIALS);
+		++num_decodes;
+	}
+	pool.wait();
+	for (int j = 0; j < BLOCKS; j += SIMD_WIDTH) {
+		int blocks = j + SIMD_WIDTH > BLOCKS ? BLOCKS - j : SIMD_WIDTH;
+		int count = counts[j];
+		if (count < 0) {
+			iterations += blocks * TRIALS;
+			std::cerr << "decoder failed at converging to a code word!" << std::endl;
+		} else {
+			iterations += blocks * (TRIALS - count);
+			std::cerr << TRIALS - count << " iterations were needed." << std::endl;
+		}
+	}
+	delete[] counts;
+#elif 0
+	for (int j = 0; j < BLOCKS; j += dispatch->width()) {
+		int blocks = j + dispatch->width() > BLOCKS ? BLOCKS - j : dispatch->width();
+		int trials = TRIALS;
+		int count = (*dispatch)(code + j * CODE_LEN, blocks, trials);
+		++num_decodes;
+		if (count < 0) {
+			iterations += blocks * trials;
+			std::cerr << "decoder failed at converging to a code word!" << std::endl;
+		} else {
+			iterations += blocks * (trials - count);
+			std::cerr << trials - count << " iterations were needed." << std::endl;
+		}
+	}
+	delete dispatch;
+#elif 0
 	for (int j = 0; j < BLOCKS; j += SIMD_WIDTH) {
 		int blocks = j + SIMD_WIDTH > BLOCKS ? BLOCKS - j : SIMD_WIDTH;
-		for (int n = 0; n < blocks; ++n)
-			for (int i = 0; i < CODE_LEN; ++i)
-				reinterpret_cast<code_type *>(simd+i)[n] = code[(j+n)*CODE_LEN+i];
+		pack(simd, code + j * CODE_LEN, CODE_LEN, blocks);
 		int trials = TRIALS;
+		int count = multi(multi_code, simd, simd + DATA_LEN, trials, blocks);
+		++num_decodes;
+		unpack(code + j * CODE_LEN, simd, CODE_LEN, blocks);
+		if (count < 0) {
+			iterations += blocks * trials;
+			std::cerr << "decoder failed at converging to a code word!" << std::endl;
+		} else {
+			iterations += blocks * (trials - count);
+			std::cerr << trials - count << " iterations were needed." << std::endl;
+		}
+	}
+#elif 0
+	int *counts = new int[BLOCKS];
+	for (int j = 0; j < BLOCKS; ++j)
+		sched.push(sched_code, code + j * CODE_LEN, counts + j);
+	sched.flush();
+	num_decodes = sched.decodes();
+	for (int j = 0; j < BLOCKS; ++j) {
+		if (counts[j] < 0) {
+			iterations += TRIALS;
+			std::cerr << "decoder failed at converging to a code word!" << std::endl;
+		} else {
+			iterations += TRIALS - counts[j];
+			std::cerr << TRIALS - counts[j] << " iterations were needed." << std::endl;
+		}
+	}
+	delete[] counts;
+#else
+	for (int j = 0; j < BLOCKS; j += SIMD_WIDTH) {
+		int blocks = j + SIMD_WIDTH > BLOCKS ? BLOCKS - j : SIMD_WIDTH;
+#if 0
+		(*demap)(reinterpret_cast<code_type *>(simd), symb + j * SYMBOLS, blocks, precision);
+#elif DEINTERLEAVE_LANES
+		pack(lanes_tmp, code + j * CODE_LEN, CODE_LEN, blocks);
+		lanes->bwd(simd, lanes_tmp, lanes_scratch);
+#else
+		pack(simd, code + j * CODE_LEN, CODE_LEN, blocks);
+#endif
+		int trials = TRIALS;
+#if 0
+		int count = table_decode(simd, simd + DATA_LEN, trials, blocks);
+#elif 0
+		int count = decode.fused(simd, simd + DATA_LEN, trials, blocks);
+#else
 		int count = decode(simd, simd + DATA_LEN, trials, blocks);
+#endif
 		++num_decodes;
-		for (int n = 0; n < blocks; ++n)
-			for (int i = 0; i < CODE_LEN; ++i)
-				code[(j+n)*CODE_LEN+i] = reinterpret_cast<code_type *>(simd+i)[n];
+		unpack(code + j * CODE_LEN, simd, CODE_LEN, blocks);
 		if (count < 0) {
 			iterations += blocks * trials;
 			std::cerr << "decoder failed at converging to a code word!" << std::endl;
@@ -173,6 +420,7 @@ int main(int argc, char **argv)
 			std::cerr << trials - count << " iterations were needed." << std::endl;
 		}
 	}
+#endif
 	auto end = std::chrono::system_clock::now();
 	auto msec = std::chrono::duration_cast<std::chrono::milliseconds>(end - start);
 	int kbs = (BLOCKS * DATA_LEN + msec.count() / 2) / msec.count();
@@ -202,7 +450,7 @@ int main(int argc, char **argv)
 	if (1) {
 		for (int i = 0; i < CODE_LEN; ++i)
 			code[i] = code[i] < 0 ? -1 : 1;
-		itl->fwd(code);
+		itl->fwd(code, scratch);
 		value_type sp = 0, np = 0;
 		for (int i = 0; i < SYMBOLS; ++i) {
 			complex_type s = mod->map(code + i * MOD_BITS);
@@ -229,12 +477,21 @@ int main(int argc, char **argv)
 	delete ldpc;
 	delete mod;
 	delete itl;
+#if 0
+	delete demap;
+#endif
+#if DEINTERLEAVE_LANES
+	delete lanes;
+	delete[] lanes_tmp;
+	delete[] lanes_scratch;
+#endif
 
 	delete[] simd;
 	delete[] code;
 	delete[] orig;
 	delete[] noisy;
 	delete[] symb;
+	delete[] scratch;
 
 	return 0;
 }
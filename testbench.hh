@@ -8,7 +8,9 @@ Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
 #include <complex>
 #include "simd.hh"
 
-#ifdef __AVX2__
+#ifdef __AVX512BW__
+const int SIZEOF_SIMD = 64;
+#elif defined(__AVX2__)
 const int SIZEOF_SIMD = 32;
 #else
 const int SIZEOF_SIMD = 16;
@@ -20,6 +22,9 @@ typedef std::complex<value_type> complex_type;
 #if 1
 typedef int8_t code_type;
 const int FACTOR = 2;
+#elif 0
+typedef int16_t code_type;
+const int FACTOR = 32;
 #else
 typedef float code_type;
 const int FACTOR = 1;
@@ -0,0 +1,118 @@
+/*
+Transpose frames into and out of SIMD lanes
+
+Copyright 2018 Ahmet Inan <xdsopl@gmail.com>
+*/
+
+#ifndef TRANSPOSE_HH
+#define TRANSPOSE_HH
+
+#include <cstring>
+#include "simd.hh"
+
+// each stage moves the top bit of the row index to the bottom of the column index and vice versa
+template <typename TYPE, int WIDTH>
+static inline void vtranspose(SIMD<TYPE, WIDTH> *a)
+{
+	SIMD<TYPE, WIDTH> tmp[WIDTH];
+	for (int s = 1; s < WIDTH; s *= 2) {
+		for (int i = 0; i < WIDTH / 2; ++i) {
+			tmp[2*i] = vzip1(a[i], a[WIDTH/2+i]);
+			tmp[2*i+1] = vzip2(a[i], a[WIDTH/2+i]);
+		}
+		for (int i = 0; i < WIDTH; ++i)
+			a[i] = tmp[i];
+	}
+}
+
+// count frames of len elements each into lane n of len vectors, the lanes from count on get zeroed
+template <typename TYPE, int WIDTH>
+static void pack(SIMD<TYPE, WIDTH> *lanes, const TYPE *const *frames, int len, int count)
+{
+	int i = 0;
+	for (; i + WIDTH <= len; i += WIDTH) {
+		SIMD<TYPE, WIDTH> tmp[WIDTH];
+		// too many frames too far apart for the hardware prefetcher
+		for (int n = 0; n < count; ++n) {
+			__builtin_prefetch(frames[n] + i + 4 * WIDTH);
+			std::memcpy(tmp + n, frames[n] + i, sizeof(tmp[n]));
+		}
+		for (int n = count; n < WIDTH; ++n)
+			tmp[n] = vzero<SIMD<TYPE, WIDTH>>();
+		vtranspose(tmp);
+		for (int k = 0; k < WIDTH; ++k)
+			lanes[i+k] = tmp[k];
+	}
+	for (; i < len; ++i) {
+		for (int n = 0; n < count; ++n)
+			lanes[i].v[n] = frames[n][i];
+		for (int n = count; n < WIDTH; ++n)
+			lanes[i].v[n] = 0;
+	}
+}
+
+template <typename TYPE, int WIDTH>
+static void unpack(TYPE *const *frames, const SIMD<TYPE, WIDTH> *lanes, int len, int count)
+{
+	int i = 0;
+	for (; i + WIDTH <= len; i += WIDTH) {
+		SIMD<TYPE, WIDTH> tmp[WIDTH];
+		for (int k = 0; k < WIDTH; ++k)
+			tmp[k] = lanes[i+k];
+		vtranspose(tmp);
+		for (int n = 0; n < count; ++n) {
+			__builtin_prefetch(frames[n] + i + 4 * WIDTH, 1);
+			std::memcpy(frames[n] + i, tmp + n, sizeof(tmp[n]));
+		}
+	}
+	for (; i < len; ++i)
+		for (int n = 0; n < count; ++n)
+			frames[n][i] = lanes[i].v[n];
+}
+
+// same for frames stored one after another
+template <typename TYPE, int WIDTH>
+static void pack(SIMD<TYPE, WIDTH> *lanes, const TYPE *frames, int len, int count)
+{
+	const TYPE *tmp[WIDTH];
+	for (int n = 0; n < count; ++n)
+		tmp[n] = frames + len * n;
+	pack(lanes, tmp, len, count);
+}
+
+template <typename TYPE, int WIDTH>
+static void unpack(TYPE *frames, const SIMD<TYPE, WIDTH> *lanes, int len, int count)
+{
+	TYPE *tmp[WIDTH];
+	for (int n = 0; n < count; ++n)
+		tmp[n] = frames + len * n;
+	unpack(tmp, lanes, len, count);
+}
+
+template <typename TYPE>
+static void pack(TYPE *lanes, const TYPE *frames, int len, int)
+{
+	for (int i = 0; i < len; ++i)
+		lanes[i] = frames[i];
+}
+
+template <typename TYPE>
+static void unpack(TYPE *frames, const TYPE *lanes, int len, int)
+{
+	for (int i = 0; i < len; ++i)
+		frames[i] = lanes[i];
+}
+
+template <typename TYPE>
+static void pack(TYPE *lanes, const TYPE *const *frames, int len, int)
+{
+	pack(lanes, frames[0], len, 1);
+}
+
+template <typename TYPE>
+static void unpack(TYPE *const *frames, const TYPE *lanes, int len, int)
+{
+	unpack(frames[0], lanes, len, 1);
+}
+
+#endif